@@ -0,0 +1,36 @@
+//
+// Created by Samuel He on 2025/11/14.
+//
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bit i of a line mask is the i-th cell along the line, walking in the line's direction
+using LineMask = uint32_t;
+
+// Index of the lowest set bit. `mask` must be non-zero.
+[[nodiscard]] inline int lowestBit(const uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Index of the highest set bit. `mask` must be non-zero.
+[[nodiscard]] inline int highestBit(const uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return static_cast<int>(index);
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
@@ -4,33 +4,144 @@
 
 #include "BoardManager.h"
 
-BoardManager::BoardManager() {
-    // Reserve capacity to avoid rehashing during game
-    candidateMovesCache.reserve(64);
+template <int Size>
+BasicBoardManager<Size>::BasicBoardManager() {
     // Calculate manhattan distances from center
-    const int center = BOARD_SIZE / 2;
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
+    const int center = Size / 2;
+    for (int row = 0; row < Size; ++row) {
+        for (int col = 0; col < Size; ++col) {
             centerManhattanDistance[row][col] = std::abs(center - row) + std::abs(center - col);
         }
     }
 }
 
-const std::vector<BoardPosition> BoardManager::criticalPoints = {
-    {3, 3}, {3, 11}, {7, 7}, {11, 3}, {11, 11}
+template <int Size>
+const typename BasicBoardManager<Size>::LineMaskTable BasicBoardManager<Size>::validLineMasks = [] {
+    LineMaskTable masks{};
+    for (int row = 0; row < Size; ++row) {
+        for (int col = 0; col < Size; ++col) {
+            for (int direction = 0; direction < LINE_DIRECTIONS; ++direction) {
+                const auto [line, index] = lineCoordinates(direction, row, col);
+                masks[direction][line] |= LineMask(1) << index;
+            }
+        }
+    }
+    return masks;
+}();
+
+template <int Size>
+typename BasicBoardManager<Size>::ZobristTable BasicBoardManager<Size>::generateZobristKeys() {
+    ZobristTable keys{};
+    // splitmix64 with a fixed seed, so keys are stable between runs
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (auto& player : keys) {
+        for (auto& row : player) {
+            for (auto& key : row) {
+                uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                key = z ^ (z >> 31);
+            }
+        }
+    }
+    return keys;
+}
+
+template <int Size>
+const typename BasicBoardManager<Size>::ZobristTable BasicBoardManager<Size>::zobristKeys = generateZobristKeys();
+
+template <int Size>
+const typename BasicBoardManager<Size>::SymmetricZobristTable BasicBoardManager<Size>::symmetricZobristKeys = [] {
+    // Regenerated rather than read from zobristKeys: the two statics have no initialization order
+    const ZobristTable base = generateZobristKeys();
+    SymmetricZobristTable keys{};
+    for (int player = 0; player < 2; ++player) {
+        for (int row = 0; row < Size; ++row) {
+            for (int col = 0; col < Size; ++col) {
+                for (int symmetry = 0; symmetry < SYMMETRIES; ++symmetry) {
+                    const BoardPosition image = transform({row, col}, symmetry);
+                    keys[player][row * Size + col][symmetry] = base[player][image.row][image.col];
+                }
+            }
+        }
+    }
+    return keys;
+}();
+
+template <int Size>
+const std::vector<BoardPosition> BasicBoardManager<Size>::criticalPoints = {
+    {3, 3}, {3, Size - 4}, {Size / 2, Size / 2}, {Size - 4, 3}, {Size - 4, Size - 4}
 };
 
-void BoardManager::_makeMove(BoardPosition position) {
-    board[position.row][position.col] = _blackTurn ? BLACK : WHITE;
+template <int Size>
+void BasicBoardManager<Size>::toggleStone(const BoardPosition position, const char player) {
+    auto& playerLines = lines[player - 1];
+    for (int direction = 0; direction < LINE_DIRECTIONS; ++direction) {
+        const auto [line, index] = lineCoordinates(direction, position.row, position.col);
+        playerLines[direction][line] ^= LineMask(1) << index;
+    }
+    const auto& keys = symmetricZobristKeys[player - 1][position.row * Size + position.col];
+    for (int symmetry = 0; symmetry < SYMMETRIES; ++symmetry) {
+        symmetricKeys[symmetry] ^= keys[symmetry];
+    }
+}
+
+template <int Size>
+BoardPosition BasicBoardManager<Size>::transform(const BoardPosition position, const int symmetry) {
+    int row = position.row;
+    int col = symmetry & 4 ? Size - 1 - position.col : position.col;
+    for (int turn = 0; turn < (symmetry & 3); ++turn) {
+        const int previousRow = row;
+        row = col;
+        col = Size - 1 - previousRow;
+    }
+    return {row, col};
+}
+
+template <int Size>
+BoardPosition BasicBoardManager<Size>::inverseTransform(const BoardPosition position, const int symmetry) {
+    int row = position.row;
+    int col = position.col;
+    for (int turn = 0; turn < (symmetry & 3); ++turn) {
+        const int previousRow = row;
+        row = Size - 1 - col;
+        col = previousRow;
+    }
+    return {row, symmetry & 4 ? Size - 1 - col : col};
+}
+
+template <int Size>
+void BasicBoardManager<Size>::rescoreLinesThrough(const BoardPosition position) {
+    for (int direction = 0; direction < LINE_DIRECTIONS; ++direction) {
+        const auto [line, index] = lineCoordinates(direction, position.row, position.col);
+        const LineMask black = lines[0][direction][line];
+        const LineMask white = lines[1][direction][line];
+        const LineMask empty = validLineMasks[direction][line] & ~(black | white);
+
+        for (int player = 0; player < 2; ++player) {
+            SequenceSummary& cached = lineSummaries[player][direction][line];
+            summaryTotals[player] -= cached;
+            cached = scoreLine(player == 0 ? black : white, empty);
+            summaryTotals[player] += cached;
+        }
+    }
+}
+
+template <int Size>
+void BasicBoardManager<Size>::_makeMove(BoardPosition position) {
+    const char player = _blackTurn ? BLACK : WHITE;
+    toggleStone(position, player);
+    rescoreLinesThrough(position);
+    centerBiasTotals[player - 1] += std::max(1, Size - centerManhattanDistance[position.row][position.col]);
     _blackTurn = !_blackTurn; // Switch turn
-    
-    MoveRecord record;
+
+    MoveRecord& record = movesHistory[moveCount++];
     record.position = position;
-    record.candidatesDelta = updateCandidatesCache(position);
-    movesHistory.push_back(record);
+    updateCandidatesCache(record);
 }
 
-char BoardManager::makeMove(const BoardPosition position) {
+template <int Size>
+char BasicBoardManager<Size>::makeMove(const BoardPosition position) {
     if (!isValidMove(position)) { 
         std::cerr << "Invalid move attempted: " << position << std::endl;
         return EMPTY; // Invalid move
@@ -40,135 +151,146 @@ char BoardManager::makeMove(const BoardPosition position) {
     return checkWinner();
 }
 
-void BoardManager::undoMove() {
-    if (movesHistory.empty()) return;
-    
-    MoveRecord lastRecord = movesHistory.back();
-    BoardPosition position = lastRecord.position;
-    
-    // Reset the board position
-    board[position.row][position.col] = EMPTY;
+template <int Size>
+void BasicBoardManager<Size>::undoMove() {
+    if (moveCount == 0) return;
+
+    const MoveRecord& lastRecord = movesHistory[--moveCount]; // Remove the undone move from history
+    const BoardPosition position = lastRecord.position;
 
-    reverseCandidatesCache(lastRecord.candidatesDelta, position);
-    
-    movesHistory.pop_back(); // Remove the undone move from history
     _blackTurn = !_blackTurn; // Switch turn back
+
+    // Reset the board position; the player to move is the one who placed it
+    const char player = _blackTurn ? BLACK : WHITE;
+    toggleStone(position, player);
+    rescoreLinesThrough(position);
+    centerBiasTotals[player - 1] -= std::max(1, Size - centerManhattanDistance[position.row][position.col]);
+
+    reverseCandidatesCache(lastRecord);
 }
 
-void BoardManager::reverseCandidatesCache(const CandidatesDelta& delta, BoardPosition moveUndone) {
-    // Remove all candidates that were added for this move
-    for (const auto& candidate : delta.addedCandidates) {
-        candidateMovesCache.erase(candidate);
-        candidateMap[candidate.row][candidate.col] = false;
-    }
-    
-    // If this position was in the cache before the move, add it back
-    if (delta.removedFromCache) {
-        candidateMovesCache.insert(moveUndone);
-        candidateMap[moveUndone.row][moveUndone.col] = true;
+template <int Size>
+void BasicBoardManager<Size>::makeNullMove() {
+    _blackTurn = !_blackTurn;
+    for (uint64_t& key : symmetricKeys) {
+        key ^= NULL_MOVE_KEY;
     }
 }
 
-char BoardManager::checkWinner() const {
-    if (movesHistory.empty()) return EMPTY;
+template <int Size>
+void BasicBoardManager<Size>::undoNullMove() {
+    makeNullMove();
+}
+
+template <int Size>
+void BasicBoardManager<Size>::addCandidate(const BoardPosition position) {
+    const int cell = cellIndex(position);
+    candidateBits[cell >> 6] |= uint64_t(1) << (cell & 63);
+    candidateSlot[cell] = static_cast<int16_t>(candidateCount);
+    candidateList[candidateCount++] = position;
+}
 
-    const int directions[4][2] = {
-        {0, 1},  // Horizontal
-        {1, 0},  // Vertical
-        {1, 1},  // Diagonal
-        {1, -1}  // Diagonal
-    };
+template <int Size>
+int BasicBoardManager<Size>::removeCandidate(const BoardPosition position) {
+    const int cell = cellIndex(position);
+    candidateBits[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
 
-    auto isInvalid = [&](int r, int c, char player) {
-        return r < 0 || r >= BOARD_SIZE || c < 0 || c >= BOARD_SIZE || board[r][c] != player;
-    };
+    const int slot = candidateSlot[cell];
+    const BoardPosition last = candidateList[--candidateCount];
+    candidateList[slot] = last;
+    candidateSlot[cellIndex(last)] = static_cast<int16_t>(slot);
+    return slot;
+}
 
-    const char player = _blackTurn ? WHITE : BLACK; // Last move was by the opposite player
-    BoardPosition lastMove = movesHistory.back().position;
-
-    for (const auto& dir : directions) {
-        auto [row, col] = lastMove;
-    const char currentCell = board[row][col];
-        if (currentCell == EMPTY) continue;
-        int count = 1;
-
-        // Check in the positive direction
-        for (int step = 1; step < 5; step++) {
-            int newRow = row + dir[0] * step;
-            int newCol = col + dir[1] * step;
-            if (isInvalid(newRow, newCol, currentCell)) break;
-            count++;
-        }
+template <int Size>
+void BasicBoardManager<Size>::reverseCandidatesCache(const MoveRecord& record) {
+    // Remove all candidates that were added for this move; they sit at the end of the list
+    while (addedCount > record.addedBegin) {
+        const BoardPosition candidate = addedCandidates[--addedCount];
+        const int cell = cellIndex(candidate);
+        candidateBits[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+        --candidateCount;
+    }
 
-        // Check in the negative direction
-        for (int step = 1; step < 5; step++) {
-            int newRow = row - dir[0] * step;
-            int newCol = col - dir[1] * step;
-            if (isInvalid(newRow, newCol, currentCell)) break;
-            count++;
+    // If this position was a candidate before the move, put it back in its old slot
+    // so iteration order is exactly what it was
+    if (record.removedSlot >= 0) {
+        const int slot = record.removedSlot;
+        if (slot < candidateCount) {
+            const BoardPosition displaced = candidateList[slot];
+            candidateList[candidateCount] = displaced;
+            candidateSlot[cellIndex(displaced)] = static_cast<int16_t>(candidateCount);
         }
+        ++candidateCount;
+
+        const int cell = cellIndex(record.position);
+        candidateBits[cell >> 6] |= uint64_t(1) << (cell & 63);
+        candidateSlot[cell] = static_cast<int16_t>(slot);
+        candidateList[slot] = record.position;
+    }
+}
 
-        if (count >= 5) {
-            return currentCell;
+template <int Size>
+char BasicBoardManager<Size>::checkWinner() const {
+    if (moveCount == 0) return EMPTY;
+
+    const char player = _blackTurn ? WHITE : BLACK; // Last move was by the opposite player
+    const auto [row, col] = movesHistory[moveCount - 1].position;
+    if (getCell(row, col) != player) {
+        // A null move came after it; the position before the pass had no winner
+        return EMPTY;
+    }
+
+    for (int direction = 0; direction < LINE_DIRECTIONS; ++direction) {
+        const LineView view = lineThrough(player, direction, row, col);
+        if (runThrough(view.stones, view.index).length >= 5) {
+            return player;
         }
     }
 
     return EMPTY;
 }
 
-bool BoardManager::isBoardFull() const {
-    for (const auto &row : board) {
-        for (const auto &cell : row) {
-            if (cell == EMPTY) return false;
-        }
-    }
-    return true;
+template <int Size>
+bool BasicBoardManager<Size>::isBoardFull() const {
+    return moveCount == CELL_COUNT;
 }
 
-bool BoardManager::isBoardEmpty() const {
-    for (const auto &row : board) {
-        for (const auto &cell : row) {
-            if (cell != EMPTY) return false;
-        }
-    }
-    return true;
+template <int Size>
+bool BasicBoardManager<Size>::isBoardEmpty() const {
+    return moveCount == 0;
 }
 
-BoardManager::CandidatesDelta BoardManager::updateCandidatesCache(
-    const BoardPosition pos
-) {
-    CandidatesDelta lastRecord;
-    
-    lastRecord.removedFromCache = candidateMap[pos.row][pos.col];
-    
+template <int Size>
+void BasicBoardManager<Size>::updateCandidatesCache(MoveRecord& record) {
+    const BoardPosition pos = record.position;
+    record.addedBegin = static_cast<int16_t>(addedCount);
+
     // Mark position as occupied
-    candidateMovesCache.erase(pos);
-    candidateMap[pos.row][pos.col] = false;
+    record.removedSlot = isCandidate(cellIndex(pos)) ? static_cast<int16_t>(removeCandidate(pos)) : -1;
 
     // Pre-calculate bounds
     const int minRow = std::max(0, pos.row - MAX_CANDIDATE_RADIUS);
-    const int maxRow = std::min(BOARD_SIZE - 1, pos.row + MAX_CANDIDATE_RADIUS);
+    const int maxRow = std::min(Size - 1, pos.row + MAX_CANDIDATE_RADIUS);
     const int minCol = std::max(0, pos.col - MAX_CANDIDATE_RADIUS);
-    const int maxCol = std::min(BOARD_SIZE - 1, pos.col + MAX_CANDIDATE_RADIUS);
+    const int maxCol = std::min(Size - 1, pos.col + MAX_CANDIDATE_RADIUS);
 
     for (int newRow = minRow; newRow <= maxRow; ++newRow) {
         for (int newCol = minCol; newCol <= maxCol; ++newCol) {
             // Skip the center position and occupied cells
-            if ((newRow == pos.row && newCol == pos.col) || board[newRow][newCol] != EMPTY) {
+            if ((newRow == pos.row && newCol == pos.col) || getCell(newRow, newCol) != EMPTY) {
                 continue;
             }
-            
-            if (!candidateMap[newRow][newCol]) {
-                BoardPosition newPos{newRow, newCol};
-                lastRecord.addedCandidates.push_back(newPos);
-                candidateMap[newRow][newCol] = true;
+
+            if (!isCandidate(newRow * Size + newCol)) {
+                const BoardPosition newPos{newRow, newCol};
+                addedCandidates[addedCount++] = newPos;
+                addCandidate(newPos);
             }
         }
     }
-    
-    // Batch insert all collected candidates (minor optimization ~2%)
-    candidateMovesCache.insert(lastRecord.addedCandidates.begin(), 
-                               lastRecord.addedCandidates.end());
-    
-    return lastRecord;
-}
\ No newline at end of file
+}
+
+template class BasicBoardManager<15>;
+template class BasicBoardManager<19>;
+template class BasicBoardManager<20>;
@@ -5,10 +5,15 @@
 #pragma once
 
 #include "Constants.h"
+#include "BitOps.h"
+#include "Patterns.h"
+#include <array>
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <algorithm>
-#include <unordered_set>
+#include <functional>
 
 struct BoardPosition {
     int row;
@@ -37,69 +42,256 @@ namespace std {
     template <>
     struct hash<BoardPosition> {
         size_t operator()(const BoardPosition& pos) const noexcept {
-            // Optimized hash: use bit shifting for better distribution
-            return (static_cast<size_t>(pos.row) << 4) | static_cast<size_t>(pos.col);
+            // Five bits per coordinate, so every cell up to 32x32 gets its own hash
+            return (static_cast<size_t>(pos.row) << 5) | static_cast<size_t>(pos.col);
         }
     };
 }
 
-class BoardManager {
+// The four lines through a cell, matching the {0,1}, {1,0}, {1,1}, {1,-1} step directions
+enum LineDirection {
+    Horizontal = 0,
+    Vertical = 1,
+    Diagonal = 2,
+    AntiDiagonal = 3
+};
+
+// Board state and rules for a Size x Size board. Instantiated for every size in
+// SUPPORTED_BOARD_SIZES, so all loop bounds and table sizes stay compile-time constants.
+template <int Size>
+class BasicBoardManager {
+    static_assert(Size >= 5 && Size <= 30, "a line must fit in a LineMask with a spare bit on each side");
+
 public:
-    BoardManager();
+    BasicBoardManager();
+
+    static constexpr int LINE_DIRECTIONS = 4;
+    // Rows and columns use the first Size slots, diagonals use all of them
+    static constexpr int LINES_PER_DIRECTION = 2 * Size - 1;
+
+    // One player's stones and the empty cells along a line, plus the bit of the queried cell
+    struct LineView {
+        LineMask stones;
+        LineMask empty;
+        int index;
+    };
+
+    // A contiguous run of set bits in a line mask
+    struct LineRun {
+        int start;
+        int length;
+    };
 
     // Returns EMPTY if no winner after the move, BLACK if black wins, WHITE if white wins
     char makeMove(BoardPosition position);
     void undoMove();
 
+    // Passes the turn without placing a stone, for null-move pruning. Pairs with
+    // undoNullMove(), which must come before any undoMove() of earlier moves. The key changes
+    // too, so the position doesn't share table entries with the same stones, other side to move.
+    void makeNullMove();
+    void undoNullMove();
+
     // Returns EMPTY if no winner, BLACK if black wins, WHITE if white wins
     [[nodiscard]] char checkWinner() const;
 
-    [[nodiscard]] inline char getCell(const int row, const int col) const { return board[row][col]; }
-    [[nodiscard]] inline char getCell(const BoardPosition position) const { return board[position.row][position.col]; }
-    int centerManhattanDistance[BOARD_SIZE][BOARD_SIZE];
+    [[nodiscard]] inline char sideToMove() const { return _blackTurn ? BLACK : WHITE; }
+    [[nodiscard]] inline int movesPlayed() const { return moveCount; }
+
+    [[nodiscard]] inline char getCell(const int row, const int col) const {
+        if (lines[0][Horizontal][row] >> col & 1) return BLACK;
+        if (lines[1][Horizontal][row] >> col & 1) return WHITE;
+        return EMPTY;
+    }
+    [[nodiscard]] inline char getCell(const BoardPosition position) const { return getCell(position.row, position.col); }
+    int centerManhattanDistance[Size][Size];
     [[nodiscard]] inline bool isValidMove(BoardPosition position) const {
-        return position.row >= 0 && position.row < BOARD_SIZE &&
-               position.col >= 0 && position.col < BOARD_SIZE &&
-               board[position.row][position.col] == EMPTY;
+        return position.row >= 0 && position.row < Size &&
+               position.col >= 0 && position.col < Size &&
+               getCell(position) == EMPTY;
+    }
+
+    // Maps a cell to (line, bit) within the given direction
+    [[nodiscard]] inline static std::pair<int, int> lineCoordinates(const int direction, const int row, const int col) {
+        switch (direction) {
+            case Horizontal: return {row, col};
+            case Vertical: return {col, row};
+            case Diagonal: return {row - col + Size - 1, col};
+            default: return {row + col, Size - 1 - col};
+        }
+    }
+
+    [[nodiscard]] inline LineView lineThrough(const char player, const int direction, const int row, const int col) const {
+        const auto [line, index] = lineCoordinates(direction, row, col);
+        const LineMask black = lines[0][direction][line];
+        const LineMask white = lines[1][direction][line];
+        return {
+            player == BLACK ? black : white,
+            validLineMasks[direction][line] & ~(black | white),
+            index
+        };
     }
 
+    // Row masks for the whole-board threat kernels
+    [[nodiscard]] inline LineMask rowStones(const char player, const int row) const {
+        return lines[player == BLACK ? 0 : 1][Horizontal][row];
+    }
+    [[nodiscard]] inline LineMask rowEmpty(const int row) const {
+        return validLineMasks[Horizontal][row] & ~(lines[0][Horizontal][row] | lines[1][Horizontal][row]);
+    }
+
+    // The run of set bits containing `index`, treating `index` itself as set
+    [[nodiscard]] inline static LineRun runThrough(LineMask stones, const int index) {
+        stones |= LineMask(1) << index;
+        const int above = lowestBit(~(stones >> index));
+        const LineMask gapsBelow = ~stones & ((LineMask(1) << index) - 1);
+        const int below = gapsBelow ? index - 1 - highestBit(gapsBelow) : index;
+        return {index - below, above + below};
+    }
+
+    // Bits outside the line (negative or past the end) are never empty
+    [[nodiscard]] inline static bool isEmptyAt(const LineMask empty, const int bit) {
+        return bit >= 0 && (empty >> bit & 1);
+    }
+
+    // Zobrist key of the current position, maintained incrementally by make/undo
+    [[nodiscard]] inline uint64_t hash() const { return symmetricKeys[0]; }
+    // Key the position would have after the side to move played at position
+    [[nodiscard]] inline uint64_t hashAfter(const BoardPosition position) const {
+        return symmetricKeys[0] ^ zobristKeys[_blackTurn ? 0 : 1][position.row][position.col];
+    }
+
+    // The 8 symmetries of the square board. Bit 2 mirrors the columns, then bits 0-1 give the
+    // number of clockwise quarter turns; 0 is the identity.
+    static constexpr int SYMMETRIES = 8;
+    [[nodiscard]] static BoardPosition transform(BoardPosition position, int symmetry);
+    [[nodiscard]] static BoardPosition inverseTransform(BoardPosition position, int symmetry);
+
+    // Zobrist key of the position's image under a symmetry, maintained incrementally like hash()
+    [[nodiscard]] inline uint64_t symmetricHash(const int symmetry) const { return symmetricKeys[symmetry]; }
+
+    // Smallest key over the 8 images of the position, and the symmetry that maps the position
+    // to that image. Equal for all positions that are rotations or mirrors of each other.
+    [[nodiscard]] inline std::pair<uint64_t, int> canonicalHash() const {
+        int best = 0;
+        for (int symmetry = 1; symmetry < SYMMETRIES; ++symmetry) {
+            if (symmetricKeys[symmetry] < symmetricKeys[best]) best = symmetry;
+        }
+        return {symmetricKeys[best], best};
+    }
+
+    // Bit s is set if symmetry s maps the position onto itself (bit 0, the identity, always is)
+    [[nodiscard]] inline int positionSymmetries() const {
+        int symmetries = 0;
+        for (int symmetry = 0; symmetry < SYMMETRIES; ++symmetry) {
+            if (symmetricKeys[symmetry] == symmetricKeys[0]) symmetries |= 1 << symmetry;
+        }
+        return symmetries;
+    }
+
+    // Pattern totals over the whole board, kept up to date by make/undo
+    [[nodiscard]] inline const SequenceSummary& sequenceSummary(const char player) const {
+        return summaryTotals[player - 1];
+    }
+
+    // Sum over the player's stones of max(1, Size - distance to center)
+    [[nodiscard]] inline int centerBias(const char player) const { return centerBiasTotals[player - 1]; }
+
     [[nodiscard]] bool isBoardFull() const;
     [[nodiscard]] bool isBoardEmpty() const;
     
-    // Return by const reference
-    [[nodiscard]] const std::unordered_set<BoardPosition>& getCandidateMoves() const {
-        return candidateMovesCache;
+    static constexpr int CELL_COUNT = Size * Size;
+
+    // Non-owning view over the candidate array; invalidated by the next make/undo
+    struct CandidateView {
+        const BoardPosition* first;
+        const BoardPosition* last;
+
+        [[nodiscard]] const BoardPosition* begin() const { return first; }
+        [[nodiscard]] const BoardPosition* end() const { return last; }
+        [[nodiscard]] size_t size() const { return static_cast<size_t>(last - first); }
+        [[nodiscard]] bool empty() const { return first == last; }
+    };
+
+    [[nodiscard]] CandidateView getCandidateMoves() const {
+        return {candidateList, candidateList + candidateCount};
     }
 
-    static const int size;
+    static constexpr int size = Size;
 
-    // Critical points on a 15x15 board
+    // Star points drawn on the board
     static const std::vector<BoardPosition> criticalPoints;
 
 private:
-    char board[BOARD_SIZE][BOARD_SIZE] = {{EMPTY}};
+    // Per-player bitboards, indexed [player - 1][direction][line]
+    LineMask lines[2][LINE_DIRECTIONS][LINES_PER_DIRECTION] = {};
     bool _blackTurn = true;
+    // Zobrist keys of the position's 8 images, indexed by symmetry; [0] is hash()
+    uint64_t symmetricKeys[SYMMETRIES] = {};
+
+    // Random keys indexed [player - 1][row][col]; the same for every board so copies stay comparable
+    using ZobristTable = std::array<std::array<std::array<uint64_t, Size>, Size>, 2>;
+    static const ZobristTable zobristKeys;
+    [[nodiscard]] static ZobristTable generateZobristKeys();
+    // Per player and cell, the key of the cell's image under each symmetry
+    using SymmetricZobristTable = std::array<std::array<std::array<uint64_t, SYMMETRIES>, Size * Size>, 2>;
+    static const SymmetricZobristTable symmetricZobristKeys;
+    // Toggled into every key by a null move. Side to move follows from the stone count
+    // otherwise, so ordinary positions keep the keys opening books are built on.
+    static constexpr uint64_t NULL_MOVE_KEY = 0xD6E8FEB86659FD93ULL;
+
+    // On-board cells of every line; diagonals are shorter than Size
+    using LineMaskTable = std::array<std::array<LineMask, LINES_PER_DIRECTION>, LINE_DIRECTIONS>;
+    static const LineMaskTable validLineMasks;
+
+    // Sets or clears a stone in all four line directions and in the Zobrist keys
+    void toggleStone(BoardPosition position, char player);
+
+    // Cached summary of every line for both players, and their running totals
+    SequenceSummary lineSummaries[2][LINE_DIRECTIONS][LINES_PER_DIRECTION];
+    SequenceSummary summaryTotals[2];
+    int centerBiasTotals[2] = {0, 0};
+
+    // Re-scores the four lines through a cell that just changed
+    void rescoreLinesThrough(BoardPosition position);
 
     // Performs the combined action of making a move, adding to history, and switching turn
     void _makeMove(BoardPosition position);
 
-    // Keep track of moves for undo and win checking with cache information
-    struct CandidatesDelta {
-        std::vector<BoardPosition> addedCandidates;  // Changed to vector for better cache locality
-        bool removedFromCache;
-    };
+    // Candidate set with no allocations after construction: a bitset answers membership,
+    // candidateList holds the members for iteration and candidateSlot locates them for O(1) removal
+    uint64_t candidateBits[(CELL_COUNT + 63) / 64] = {};
+    BoardPosition candidateList[CELL_COUNT] = {};
+    int16_t candidateSlot[CELL_COUNT] = {};
+    int candidateCount = 0;
 
-    // O(1) lookups and fast insertion/deletion
-    std::unordered_set<BoardPosition> candidateMovesCache;
-    bool candidateMap[BOARD_SIZE][BOARD_SIZE] = {{false}};
-    
-    CandidatesDelta updateCandidatesCache(BoardPosition pos);
-    void reverseCandidatesCache(const CandidatesDelta& delta, BoardPosition moveUndone);
+    [[nodiscard]] inline static int cellIndex(const BoardPosition position) {
+        return position.row * Size + position.col;
+    }
+    [[nodiscard]] inline bool isCandidate(const int cell) const {
+        return candidateBits[cell >> 6] >> (cell & 63) & 1;
+    }
+    void addCandidate(BoardPosition position);
+    // Swaps the last member into the freed slot and returns that slot
+    int removeCandidate(BoardPosition position);
 
+    // Keep track of moves for undo and win checking with cache information.
+    // A cell becomes a candidate at most once along a line of play, so the candidates
+    // added by every move in the history fit in one stack of CELL_COUNT entries.
     struct MoveRecord {
         BoardPosition position;
-        CandidatesDelta candidatesDelta;
+        int16_t addedBegin;   // First entry of this move in addedCandidates
+        int16_t removedSlot;  // Slot the move's cell held in candidateList, or -1
     };
 
-    std::vector<MoveRecord> movesHistory;
+    MoveRecord movesHistory[CELL_COUNT] = {};
+    int moveCount = 0;
+    BoardPosition addedCandidates[CELL_COUNT] = {};
+    int addedCount = 0;
+
+    void updateCandidatesCache(MoveRecord& record);
+    void reverseCandidatesCache(const MoveRecord& record);
 };
+
+// The board the GUI plays on
+using BoardManager = BasicBoardManager<BOARD_SIZE>;
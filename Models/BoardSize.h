@@ -0,0 +1,38 @@
+//
+// Created by Samuel He on 2025/11/18.
+//
+
+#pragma once
+
+#include <type_traits>
+
+// Board sizes with compiled BasicBoardManager / BasicGomokuAI instances; 20x20 is the Gomocup size.
+// Adding a size here also needs an explicit instantiation in BoardManager.cpp and GomokuAI.cpp.
+constexpr int SUPPORTED_BOARD_SIZES[] = {15, 19, 20};
+
+[[nodiscard]] constexpr bool isSupportedBoardSize(const int size) {
+    for (const int supported : SUPPORTED_BOARD_SIZES) {
+        if (supported == size) return true;
+    }
+    return false;
+}
+
+// Picks the compiled instance for a size chosen at runtime. `visitor` is called with a
+// std::integral_constant<int, size>, so it can name BasicBoardManager<decltype(arg)::value>.
+// Returns false without calling it if the size is not supported.
+template <typename Visitor>
+bool visitBoardSize(const int size, Visitor&& visitor) {
+    switch (size) {
+        case 15:
+            visitor(std::integral_constant<int, 15>{});
+            return true;
+        case 19:
+            visitor(std::integral_constant<int, 19>{});
+            return true;
+        case 20:
+            visitor(std::integral_constant<int, 20>{});
+            return true;
+        default:
+            return false;
+    }
+}
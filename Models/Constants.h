@@ -4,6 +4,7 @@
 
 #pragma once
 
+// Board the GUI plays on; other sizes are listed in BoardSize.h
 #define BOARD_SIZE 15
 
 #define EMPTY 0
@@ -11,7 +12,38 @@
 #define WHITE 2
 
 #define MAX_DEPTH 7
+// Per-move budget the GUI gives the AI, and the deepest iteration it may reach within it
+#define AI_TIME_BUDGET_MS 3000
+#define MAX_ITERATIVE_DEPTH 20
 #define MAX_CANDIDATE_RADIUS 2
 
+// Opening book looked for next to the executable, and how many plies of each game it covers
+#define OPENING_BOOK_FILE "opening_book.bin"
+#define BOOK_MAX_PLY 10
+
+// Default transposition table size per AI instance
+#define TT_DEFAULT_SIZE_MB 32
+
+// Victory-by-continuous-fours search before the full search: depth in attacker moves, node budget
+#define VCF_MAX_DEPTH 12
+#define VCF_MAX_NODES 20000
+// Smaller limits for the optional check at every leaf
+#define VCF_LEAF_MAX_DEPTH 4
+#define VCF_LEAF_MAX_NODES 64
+// Victory-by-continuous-threats search: depth in attacker moves, node budget, time limit
+#define VCT_MAX_DEPTH 8
+#define VCT_MAX_NODES 50000
+#define VCT_TIME_LIMIT_MS 300
+// Quiescence search past the depth horizon: the longest forcing line it reads, in plies,
+// and the nodes it may spend below each leaf
+#define QUIESCENCE_MAX_PLY 8
+#define QUIESCENCE_MAX_NODES 64
+// Proof-number solver: table size, node budget and the longest line it reads, in plies
+#define PN_TABLE_SIZE_MB 16
+#define PN_MAX_NODES 1000000
+#define PN_MAX_PLY 40
+
 // Toggle parallelization for performance testing
 #define ENABLE_PARALLELIZATION 1
+// Search on the human's time for the reply the AI expects
+#define ENABLE_PONDERING 1
@@ -4,6 +4,9 @@
 
 #include "GameManager.h"
 
+#include <QCoreApplication>
+#include <QFile>
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <new>
@@ -15,7 +18,9 @@ GameManager::GameManager(QObject *parent) : QObject(parent) {
 void GameManager::startNewGame(const char humanColor) {
     _humanColor = humanColor;
     _aiColor = (humanColor == BLACK) ? WHITE : BLACK;
-    _aiEngine = new GomokuAI(_aiColor);
+    // Each engine owns a transposition table, so don't leak the previous one
+    stopPondering();
+    replaceAIEngine(_aiColor);
     initializeNewGameState();
     // If AI goes first, make the first move
     if (isAITurn()) {
@@ -23,6 +28,36 @@ void GameManager::startNewGame(const char humanColor) {
     }
 }
 
+void GameManager::cancelSearch() {
+    const std::lock_guard lock(engineMutex);
+    cancelled.store(true, std::memory_order_relaxed);
+    if (_aiEngine) {
+        _aiEngine->requestStop();
+    }
+}
+
+void GameManager::replaceAIEngine(const char color) {
+    GomokuAI* engine = createAIEngine(color);
+    const std::lock_guard lock(engineMutex);
+    if (cancelled.load(std::memory_order_relaxed)) {
+        engine->requestStop();
+    }
+    delete _aiEngine;
+    _aiEngine = engine;
+}
+
+GomokuAI* GameManager::createAIEngine(const char color) {
+    // Bound the reply time rather than the depth
+    auto* engine = new GomokuAI(color);
+    engine->setTimeBudget(AI_TIME_BUDGET_MS);
+    // The book is optional; play from search alone without one
+    const QString bookPath = QCoreApplication::applicationDirPath() + "/" OPENING_BOOK_FILE;
+    if (QFile::exists(bookPath)) {
+        engine->loadOpeningBook(bookPath);
+    }
+    return engine;
+}
+
 void GameManager::initializeNewGameState() {
     boardManager = BoardManager();
     _currentTurn = BLACK;
@@ -41,7 +76,11 @@ void GameManager::handleHumanMove(const BoardPosition position) {
         MoveResult aiResult = playAIMove();
         if (aiResult.moveApplied) {
             emit moveApplied(aiResult);
+            startPondering();
         }
+    } else {
+        // The game is over; don't leave the engine searching a reply that won't be needed
+        stopPondering();
     }
 }
 
@@ -51,6 +90,7 @@ void GameManager::makeAIFirstMove() {
     MoveResult result = playAIMove();
     if (result.moveApplied) {
         emit moveApplied(result);
+        startPondering();
     }
 }
 
@@ -68,15 +108,26 @@ MoveResult GameManager::playHumanMove(const BoardPosition position) {
 
 MoveResult GameManager::playAIMove() {
     const MoveResult invalidResult = {false, _winner, boardManager.isBoardFull(), {-1, -1}};
-    if (!isAITurn() || _winner != EMPTY) {
+    if (!isAITurn() || _winner != EMPTY || cancelled.load(std::memory_order_relaxed)) {
         return invalidResult;
     }
 
     if (!_aiEngine) {
-        _aiEngine = new GomokuAI(_aiColor);
+        replaceAIEngine(_aiColor);
     }
 
-    BoardPosition aiMove = _aiEngine->getBestMove(boardManager);
+    int ponderedMs = 0;
+    BoardPosition aiMove = stopPondering(&ponderedMs);
+    if (!boardManager.isValidMove(aiMove)) {
+        // After a ponder hit cut short, the table holds the pondered iterations and the search
+        // repeats them quickly, so it only needs the rest of the budget
+        const int budget = _aiEngine->getTimeBudget();
+        if (ponderedMs > 0 && budget > 0) {
+            _aiEngine->setTimeBudget(std::max(budget - ponderedMs, budget / 4));
+        }
+        aiMove = _aiEngine->getBestMove(boardManager);
+        _aiEngine->setTimeBudget(budget);
+    }
     if (!boardManager.isValidMove(aiMove)) {
         std::cerr << "AI attempted invalid move at " << aiMove << std::endl;
         return invalidResult;
@@ -85,6 +136,61 @@ MoveResult GameManager::playAIMove() {
     return applyMove(aiMove);
 }
 
+void GameManager::startPondering() {
+    if (!ENABLE_PONDERING || !_aiEngine || pondering || !isHumansTurn() || _winner != EMPTY ||
+        cancelled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    BoardManager board = boardManager;
+    const BoardPosition expected = _aiEngine->predictedMove(board);
+    if (expected.row >= 0 && (board.makeMove(expected) != EMPTY || board.isBoardFull())) {
+        // The expected reply ends the game; nothing to prepare
+        return;
+    }
+
+    ponderKey = board.hash();
+    ponderStart = std::chrono::steady_clock::now();
+    pondering = true;
+    GomokuAI* engine = _aiEngine;
+    ponderSearch = QtConcurrent::run([engine, board] { return engine->getBestMove(board); });
+}
+
+BoardPosition GameManager::stopPondering(int* elapsedMs) {
+    if (elapsedMs) {
+        *elapsedMs = 0;
+    }
+    if (!pondering) {
+        return {-1, -1};
+    }
+    pondering = false;
+
+    const bool completed = ponderSearch.isFinished();
+    if (!completed) {
+        _aiEngine->requestStop();
+    }
+    const BoardPosition move = ponderSearch.result();
+    {
+        // A cancel must stay in force
+        const std::lock_guard lock(engineMutex);
+        if (!cancelled.load(std::memory_order_relaxed)) {
+            _aiEngine->clearStop();
+        }
+    }
+
+    if (ponderKey != boardManager.hash()) {
+        return {-1, -1};
+    }
+    if (completed) {
+        return move;
+    }
+    if (elapsedMs) {
+        const auto elapsed = std::chrono::steady_clock::now() - ponderStart;
+        *elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    }
+    return {-1, -1};
+}
+
 MoveResult GameManager::applyMove(const BoardPosition position) {
     MoveResult result;
     result.position = position;
@@ -6,9 +6,13 @@
 
 #include "BoardManager.h"
 #include "GomokuAI.h"
+#include <QFuture>
 #include <QObject>
 #include <QTimer>
 #include <QMetaType>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 // Summary of a move application, used by the UI to refresh state without
 // re-querying the entire manager.
@@ -28,6 +32,7 @@ class GameManager : public QObject {
 public:
     explicit GameManager(QObject *parent = nullptr);
     ~GameManager() {
+        stopPondering();
         delete _aiEngine;
     }
 
@@ -46,6 +51,11 @@ public:
     [[nodiscard]] bool isBoardFull() const { return boardManager.isBoardFull(); }
     [[nodiscard]] bool isBoardEmpty() const { return boardManager.isBoardEmpty(); }
 
+    // Stops the running AI search, if any, within a few nodes and keeps the manager from
+    // starting another. Call from any thread before shutting down the one the manager lives
+    // on, so waiting for it doesn't wait out a whole search.
+    void cancelSearch();
+
 public slots:
     // Configure the player colors and initialize a fresh game state.
     void startNewGame(char humanColor);
@@ -63,6 +73,7 @@ private:
     MoveResult playHumanMove(BoardPosition position);
     MoveResult playAIMove();
     MoveResult applyMove(BoardPosition position);
+    static GomokuAI* createAIEngine(char color);
 
     BoardManager boardManager;
     char _humanColor = BLACK;
@@ -70,6 +81,26 @@ private:
     char _currentTurn = BLACK;
     char _winner = EMPTY;
     GomokuAI* _aiEngine = nullptr;
+    // Guards _aiEngine being replaced and its stop being cleared against cancelSearch()
+    std::mutex engineMutex;
+    std::atomic<bool> cancelled{false};
+
+    // Replaces the engine with a fresh one for color
+    void replaceAIEngine(char color);
+
+    // Pondering: while the human thinks, the engine searches the position after the reply it
+    // expects (or the current position if it has no guess) on a pool thread, warming its
+    // transposition table. The engine must not be used for anything else until stopPondering().
+    QFuture<BoardPosition> ponderSearch;
+    bool pondering = false;
+    uint64_t ponderKey = 0; // Position the ponder search is for
+    std::chrono::steady_clock::time_point ponderStart;
+
+    void startPondering();
+    // Stops the ponder search and waits for it. Returns its move if it ran to completion on
+    // the position now on the board; otherwise {-1, -1} and `elapsedMs` gets the time it
+    // spent on that position, 0 if it pondered something else.
+    BoardPosition stopPondering(int* elapsedMs = nullptr);
     
     // Clear board and manager state to the beginning of a new game
     void initializeNewGameState();
@@ -4,75 +4,388 @@
 
 #include "GomokuAI.h"
 #include "BoardManager.h"
+#include "ThreatKernels.h"
+#include <bitset>
+#include <cstdlib>
+#include <thread>
 
-GomokuAI::GomokuAI(const char color, const int maxDepth)
+template <int Size>
+BasicGomokuAI<Size>::BasicGomokuAI(const char color, const int maxDepth)
     : _color(color), _maxDepth(maxDepth) {
         threadPool.setMaxThreadCount(threadCount);
     };
 
-BoardPosition GomokuAI::getBestMove(const BoardManager &boardManager) const {
+template <int Size>
+BoardPosition BasicGomokuAI<Size>::getBestMove(const BoardManager &boardManager) const {
+    // Moves played without a search report none
+    nodesSearched.store(0, std::memory_order_relaxed);
+    completedDepth = 0;
     if (QThread::currentThread()->isInterruptionRequested()) {
         return {-1, -1};
     }
     if (boardManager.isBoardEmpty()) {
-        return {BOARD_SIZE / 2, BOARD_SIZE / 2};
+        return {Size / 2, Size / 2};
+    }
+    const BoardPosition bookMove = openingBook.probe(boardManager);
+    if (bookMove.row >= 0) {
+        return bookMove;
     }
 
     BoardManager simulatedBoard = boardManager;
-    
-#if ENABLE_PARALLELIZATION
-    return minimaxAlphaBetaRootParallel(simulatedBoard, _maxDepth);
-#else
-    // Sequential mode: call minimax directly from root
-    auto [_, bestMove] = minimaxAlphaBeta(
-        simulatedBoard,
-        _maxDepth,
-        true,
-        std::numeric_limits<int>::min(),
-        std::numeric_limits<int>::max()
-    );
-    return bestMove;
-#endif
-}
+    transpositionTable.resetStats();
+    // A stop requested before this call still applies
+    searchStop.store(stopRequested.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    prepareSearchContexts();
+
+    if (_forcedWinPreCheck) {
+        const BoardPosition forcedWin = findForcedWin(simulatedBoard);
+        if (forcedWin.row >= 0) {
+            return forcedWin;
+        }
+    }
 
-bool GomokuAI::wouldWin(const BoardManager& boardManager,
-                        const BoardPosition position,
-                        const char player) const {
-    if (!boardManager.isValidMove(position)) return false;
+    if (_timeBudgetMs <= 0) {
+        auto [_, bestMove] = searchRoot(simulatedBoard, _maxDepth, {-1, -1}, -INF, INF);
+        if (!searchAborted()) {
+            completedDepth = _maxDepth;
+        }
+        return bestMove;
+    }
 
-    const int directions[4][2] = {
-        {0, 1},  // Horizontal
-        {1, 0},  // Vertical
-        {1, 1},  // Diagonal
-        {1, -1}  // Diagonal
-    };
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::milliseconds(_timeBudgetMs);
+    deadline = start + budget;
 
-    for (const auto& dir : directions) {
-        int count = 1; // Include the hypothetical move itself
+    const auto rootMoves = candidateMoves(simulatedBoard);
+    if (rootMoves.empty()) {
+        return {-1, -1};
+    }
+    BoardPosition bestMove = rootMoves.front();
+    if (rootMoves.size() == 1) {
+        // Forced win or block, nothing to search
+        return bestMove;
+    }
 
-        for (int step = 1; step < 5; ++step) {
-            const int newRow = position.row + dir[0] * step;
-            const int newCol = position.col + dir[1] * step;
-            if (newRow < 0 || newRow >= BOARD_SIZE ||
-                newCol < 0 || newCol >= BOARD_SIZE ||
-                boardManager.getCell(newRow, newCol) != player) {
+    // Each iteration leaves its principal variation in the transposition table, which orders
+    // the next one; the previous best root move is also searched first
+    int previousScore = 0;
+    for (int depth = 1; depth <= MAX_ITERATIVE_DEPTH; ++depth) {
+        // Aspiration window: expect a score near the previous iteration's and widen on a miss
+        int delta = ASPIRATION_WINDOW;
+        int alpha = depth > 1 ? std::max(-INF, previousScore - delta) : -INF;
+        int beta = depth > 1 ? std::min(INF, previousScore + delta) : INF;
+
+        std::pair<int, BoardPosition> result;
+        while (true) {
+            result = searchRoot(simulatedBoard, depth, bestMove, alpha, beta);
+            if (searchAborted() || (result.first > alpha && result.first < beta)) {
                 break;
             }
-            count++;
+            delta *= 4;
+            if (result.first <= alpha) {
+                alpha = delta > WIN_SCORE ? -INF : std::max(-INF, result.first - delta);
+            } else {
+                beta = delta > WIN_SCORE ? INF : std::min(INF, result.first + delta);
+            }
         }
 
-        for (int step = 1; step < 5; ++step) {
-            const int newRow = position.row - dir[0] * step;
-            const int newCol = position.col - dir[1] * step;
-            if (newRow < 0 || newRow >= BOARD_SIZE ||
-                newCol < 0 || newCol >= BOARD_SIZE ||
-                boardManager.getCell(newRow, newCol) != player) {
-                break;
+        if (searchAborted()) {
+            // Unfinished iteration, keep the previous one's move
+            break;
+        }
+        const auto [score, move] = result;
+        bestMove = move;
+        previousScore = score;
+        completedDepth = depth;
+
+        // A forced win or loss won't change with more depth
+        if (std::abs(score) >= WIN_SCORE) {
+            break;
+        }
+        // The next iteration takes several times longer than this one; don't start what can't finish
+        if (std::chrono::steady_clock::now() - start > budget / 2) {
+            break;
+        }
+    }
+
+    return bestMove;
+}
+
+template <int Size>
+BoardPosition BasicGomokuAI<Size>::findForcedWin(BoardManager& boardManager) const {
+    // A forced win by continuous fours is found far sooner than the full search would
+    vcfSolver.setStopToken(&searchStop);
+    const BoardPosition forcedWin = vcfSolver.findWin(boardManager, _color);
+    if (forcedWin.row >= 0) {
+        return forcedWin;
+    }
+
+    // Then one that also uses open threes, kept to a small share of the move's time. A
+    // fixed-depth search has no budget to take a share of, so that scales with the depth.
+    const int threatTimeLimit = _timeBudgetMs > 0
+        ? std::min(VCT_TIME_LIMIT_MS, _timeBudgetMs / 10)
+        : std::max(1, VCT_TIME_LIMIT_MS * std::min(_maxDepth, MAX_DEPTH) / MAX_DEPTH);
+    BoardPosition threatWin{-1, -1};
+    if (proofSolver) {
+        proofSolver->setTimeLimit(threatTimeLimit);
+        proofSolver->setStopToken(&searchStop);
+        proofSolver->prove(boardManager, _color, &threatWin);
+    } else {
+        vctSolver.setTimeLimit(threatTimeLimit);
+        vctSolver.setStopToken(&searchStop);
+        threatWin = vctSolver.findWin(boardManager, _color);
+    }
+    return threatWin;
+}
+
+template <int Size>
+BoardPosition BasicGomokuAI<Size>::predictedMove(const BoardManager& boardManager) const {
+    const auto canonical = tableKey(boardManager);
+    TranspositionTable::Entry cached;
+    TranspositionTable::Stats counts; // Not part of a search, so not reported
+    if (!transpositionTable.probe(canonical.first, cached, counts) || cached.bestMove.row < 0) {
+        return {-1, -1};
+    }
+    const BoardPosition move = BoardManager::inverseTransform(cached.bestMove, canonical.second);
+    return boardManager.isValidMove(move) ? move : BoardPosition{-1, -1};
+}
+
+template <int Size>
+std::pair<int, BoardPosition> BasicGomokuAI<Size>::searchRoot(
+    BoardManager& boardManager,
+    const int depth,
+    const BoardPosition firstMove,
+    const int alpha,
+    const int beta
+) const {
+    switch (_searchMode) {
+        case SearchMode::RootSplit:
+            return rootSplitSearch(boardManager, depth, firstMove, alpha, beta);
+        case SearchMode::LazySMP:
+            // The root's own table entry already puts the previous best move first
+            return lazySmpSearch(boardManager, depth, alpha, beta);
+        case SearchMode::YoungBrothersWait:
+            return youngBrothersWaitSearch(boardManager, depth, alpha, beta);
+        default: {
+            // Sequential mode: search directly from root
+            SearchContext& context = threadContext(0, depth);
+            auto result = principalVariationSearch(context, boardManager, depth, alpha, beta);
+            flushCounts(context);
+            return result;
+        }
+    }
+}
+
+template <int Size>
+std::pair<int, BoardPosition> BasicGomokuAI<Size>::lazySmpSearch(
+    BoardManager& boardManager,
+    const int depth,
+    const int alpha,
+    const int beta
+) const {
+    helpersStop.store(false, std::memory_order_relaxed);
+
+    // Copy the board before the main search starts changing it
+    std::vector<BoardManager> helperBoards(std::max(0, threadCount - 1), boardManager);
+    std::vector<QFuture<void>> helpers;
+    helpers.reserve(helperBoards.size());
+
+    for (int i = 1; i < threadCount; ++i) {
+        // Odd helpers run one ply deeper, filling the table for the next iteration
+        SearchContext* context = &threadContext(i, depth + (i & 1));
+        helpers.push_back(QtConcurrent::run(&threadPool, [this, &helperBoards, context, i] {
+            // They search the full window; their scores are only ever used through the table
+            (void)principalVariationSearch(*context, helperBoards[i - 1], context->rootDepth, -INF, INF);
+            flushCounts(*context);
+        }));
+    }
+
+    SearchContext& context = threadContext(0, depth);
+    auto result = principalVariationSearch(context, boardManager, depth, alpha, beta);
+    flushCounts(context);
+
+    helpersStop.store(true, std::memory_order_relaxed);
+    for (auto& helper : helpers) {
+        helper.waitForFinished();
+    }
+    helpersStop.store(false, std::memory_order_relaxed);
+
+    return result;
+}
+
+template <int Size>
+std::pair<int, BoardPosition> BasicGomokuAI<Size>::youngBrothersWaitSearch(
+    BoardManager& boardManager,
+    const int depth,
+    const int alpha,
+    const int beta
+) const {
+    workQueues.clear();
+    for (int i = 0; i < threadCount; ++i) {
+        workQueues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    std::vector<QFuture<void>> workers;
+    workers.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; ++i) {
+        // Helpers only search below the root, so null move works for them as for the owner
+        SearchContext* context = &threadContext(i, depth);
+        workers.push_back(QtConcurrent::run(&threadPool, [this, context] { youngBrothersWaitWorker(*context); }));
+    }
+
+    SearchContext& context = threadContext(0, depth);
+    auto result = principalVariationSearch(context, boardManager, depth, alpha, beta);
+    flushCounts(context);
+
+    // Every split point is closed by now, so the workers are only looking for work
+    helpersStop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.waitForFinished();
+    }
+    helpersStop.store(false, std::memory_order_relaxed);
+    workQueues.clear();
+
+    return result;
+}
+
+template <int Size>
+void BasicGomokuAI<Size>::youngBrothersWaitWorker(SearchContext& context) const {
+    while (!helpersStop.load(std::memory_order_relaxed)) {
+        SplitPoint* splitPoint = stealSplitPoint(context.threadIndex);
+        if (!splitPoint) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        BoardManager board = splitPoint->board;
+        context.splitPoint = splitPoint;
+        workAtSplitPoint(context, *splitPoint, board);
+        context.splitPoint = nullptr;
+        // The owner may return as soon as this drops to zero
+        splitPoint->helpers.fetch_sub(1, std::memory_order_release);
+    }
+
+    flushCounts(context);
+}
+
+template <int Size>
+typename BasicGomokuAI<Size>::SplitPoint* BasicGomokuAI<Size>::stealSplitPoint(const int thief) const {
+    for (int offset = 1; offset < threadCount; ++offset) {
+        WorkQueue& queue = *workQueues[(thief + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        // Oldest first: the split points nearest the root hold the most work
+        for (SplitPoint* splitPoint : queue.splitPoints) {
+            if (splitPoint->nextMove.load(std::memory_order_relaxed) < splitPoint->moves.size() &&
+                !splitPoint->cutoff.load(std::memory_order_relaxed)) {
+                // Joined under the queue lock, so the owner can't close the split point in between
+                splitPoint->helpers.fetch_add(1, std::memory_order_relaxed);
+                return splitPoint;
             }
-            count++;
         }
+    }
+    return nullptr;
+}
+
+template <int Size>
+void BasicGomokuAI<Size>::searchYoungerBrothers(
+    SearchContext& context,
+    BoardManager& boardManager,
+    const int depth,
+    const std::vector<BoardPosition>& moves,
+    int& alpha,
+    const int beta,
+    int& bestScore,
+    BoardPosition& bestMove
+) const {
+    SplitPoint splitPoint{boardManager, depth, beta, moves, context.splitPoint};
+    splitPoint.alpha = alpha;
+    splitPoint.bestScore = bestScore;
+    splitPoint.bestMove = bestMove;
+
+    WorkQueue& queue = *workQueues[context.threadIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.splitPoints.push_back(&splitPoint);
+    }
+
+    const SplitPoint* enclosing = context.splitPoint;
+    context.splitPoint = &splitPoint;
+    workAtSplitPoint(context, splitPoint, boardManager);
+    context.splitPoint = enclosing;
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.splitPoints.erase(std::find(queue.splitPoints.begin(), queue.splitPoints.end(), &splitPoint));
+    }
+    // No one can join any more; wait for the threads still searching its moves
+    while (splitPoint.helpers.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock(splitPoint.mutex);
+    alpha = splitPoint.alpha;
+    bestScore = splitPoint.bestScore;
+    bestMove = splitPoint.bestMove;
+}
+
+template <int Size>
+void BasicGomokuAI<Size>::workAtSplitPoint(
+    SearchContext& context,
+    SplitPoint& splitPoint,
+    BoardManager& boardManager
+) const {
+    // context.splitPoint is this split point, so a cutoff here or above ends the loop
+    while (!searchAborted(context)) {
+        const size_t index = splitPoint.nextMove.fetch_add(1, std::memory_order_relaxed);
+        if (index >= splitPoint.moves.size()) {
+            break;
+        }
+        const BoardPosition pos = splitPoint.moves[index];
 
-        if (count >= 5) {
+        int alpha;
+        {
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            alpha = splitPoint.alpha;
+        }
+
+        // Younger brothers are always searched with a null window first
+        boardManager.makeMove(pos);
+        int score = -principalVariationSearch(context, boardManager, splitPoint.depth - 1, -alpha - 1, -alpha).first;
+        if (score > alpha && score < splitPoint.beta && !searchAborted(context)) {
+            score = -principalVariationSearch(context, boardManager, splitPoint.depth - 1, -splitPoint.beta, -alpha).first;
+        }
+        boardManager.undoMove();
+
+        if (searchAborted(context)) {
+            // The score of an aborted subtree is meaningless
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(splitPoint.mutex);
+        if (score > splitPoint.bestScore) {
+            splitPoint.bestScore = score;
+            splitPoint.bestMove = pos;
+        }
+        splitPoint.alpha = std::max(splitPoint.alpha, score);
+        if (splitPoint.alpha >= splitPoint.beta) {
+            // Abort every sibling still being searched
+            splitPoint.cutoff.store(true, std::memory_order_relaxed);
+            recordCutoff(context, boardManager, pos, splitPoint.depth);
+        }
+    }
+}
+
+template <int Size>
+bool BasicGomokuAI<Size>::wouldWin(const BoardManager& boardManager,
+                        const BoardPosition position,
+                        const char player) const {
+    if (!boardManager.isValidMove(position)) return false;
+
+    for (int direction = 0; direction < BoardManager::LINE_DIRECTIONS; ++direction) {
+        const auto view = boardManager.lineThrough(player, direction, position.row, position.col);
+        // Include the hypothetical move itself
+        if (BoardManager::runThrough(view.stones, view.index).length >= 5) {
             return true;
         }
     }
@@ -80,55 +393,20 @@ bool GomokuAI::wouldWin(const BoardManager& boardManager,
     return false;
 }
 
-bool GomokuAI::posesThreat(const BoardManager& boardManager,
+template <int Size>
+bool BasicGomokuAI<Size>::posesThreat(const BoardManager& boardManager,
                            const BoardPosition position,
                            const char player) const {
     if (!boardManager.isValidMove(position)) return false;
 
-    const int directions[4][2] = {
-        {0, 1},
-        {1, 0},
-        {1, 1},
-        {1, -1}
-    };
+    for (int direction = 0; direction < BoardManager::LINE_DIRECTIONS; ++direction) {
+        const auto view = boardManager.lineThrough(player, direction, position.row, position.col);
+        const auto [start, length] = BoardManager::runThrough(view.stones, view.index);
 
-    for (const auto& dir : directions) {
-        int count = 1;
-
-        int forwardRow = position.row + dir[0];
-        int forwardCol = position.col + dir[1];
-        while (forwardRow >= 0 && forwardRow < BOARD_SIZE &&
-               forwardCol >= 0 && forwardCol < BOARD_SIZE &&
-               boardManager.getCell(forwardRow, forwardCol) == player &&
-               count < 5 // Winning condition is handled by wouldWin()
-            ) {
-            count++;
-            forwardRow += dir[0];
-            forwardCol += dir[1];
-        }
-
-        int backwardRow = position.row - dir[0];
-        int backwardCol = position.col - dir[1];
-        while (backwardRow >= 0 && backwardRow < BOARD_SIZE &&
-               backwardCol >= 0 && backwardCol < BOARD_SIZE &&
-               boardManager.getCell(backwardRow, backwardCol) == player &&
-               count < 5
-            ) {
-            count++;
-            backwardRow -= dir[0];
-            backwardCol -= dir[1];
-        }
-
-        const bool forwardOpen = forwardRow >= 0 && forwardRow < BOARD_SIZE &&
-                                 forwardCol >= 0 && forwardCol < BOARD_SIZE &&
-                                 boardManager.getCell(forwardRow, forwardCol) == EMPTY;
-
-        const bool backwardOpen = backwardRow >= 0 && backwardRow < BOARD_SIZE &&
-                                  backwardCol >= 0 && backwardCol < BOARD_SIZE &&
-                                  boardManager.getCell(backwardRow, backwardCol) == EMPTY;
-
-        if (count == 4 || count == 3) {
-            if (forwardOpen || backwardOpen) {
+        // Winning condition is handled by wouldWin()
+        if (length == 4 || length == 3) {
+            if (BoardManager::isEmptyAt(view.empty, start - 1) ||
+                BoardManager::isEmptyAt(view.empty, start + length)) {
                 return true;
             }
         }
@@ -137,34 +415,150 @@ bool GomokuAI::posesThreat(const BoardManager& boardManager,
     return false;
 }
 
-std::vector<BoardPosition> GomokuAI::candidateMoves(const BoardManager& boardManager) const {
+template <int Size>
+void BasicGomokuAI<Size>::prepareSearchContexts() const {
+    for (auto& context : searchContexts) {
+        context->clearKillers();
+        context->ageHistory();
+    }
+}
+
+template <int Size>
+typename BasicGomokuAI<Size>::SearchContext& BasicGomokuAI<Size>::threadContext(
+    const int index,
+    const int rootDepth
+) const {
+    // Only called from the thread that starts the search, before helpers are launched
+    while (static_cast<int>(searchContexts.size()) <= index) {
+        searchContexts.push_back(std::make_unique<SearchContext>());
+        searchContexts.back()->clearKillers();
+    }
+
+    SearchContext& context = *searchContexts[index];
+    context.threadIndex = index;
+    context.rootDepth = rootDepth;
+    context.nodes = 0;
+    context.tableCounts = {};
+    context.splitPoint = nullptr;
+    return context;
+}
+
+template <int Size>
+void BasicGomokuAI<Size>::flushCounts(const SearchContext& context) const {
+    nodesSearched.fetch_add(context.nodes, std::memory_order_relaxed);
+    transpositionTable.addStats(context.tableCounts);
+}
+
+template <int Size>
+void BasicGomokuAI<Size>::recordCutoff(
+    SearchContext& context,
+    const BoardManager& boardManager,
+    const BoardPosition position,
+    const int depth
+) const {
+
+    auto& killers = context.killers[boardManager.movesPlayed()];
+    if (killers[0] != position) {
+        killers[1] = killers[0];
+        killers[0] = position;
+    }
+
+    int& history = context.history[boardManager.sideToMove() == BLACK ? 0 : 1][position.row][position.col];
+    history += depth * depth;
+    if (history > HISTORY_LIMIT) {
+        context.ageHistory();
+    }
+}
+
+template <int Size>
+std::vector<BoardPosition> BasicGomokuAI<Size>::candidateMoves(
+    const BoardManager& boardManager,
+    const SearchContext* context,
+    size_t* threatCount
+) const {
     std::vector<BoardPosition> threatMoves;
     std::vector<BoardPosition> moves;
 
+    // Same classification as wouldWin()/posesThreat(), computed for every cell at once
+    const ThreatMasks ownMasks = computeThreatMasks(boardManager, _color);
+    const ThreatMasks opponentMasks = computeThreatMasks(boardManager, getOpponent(_color));
+
+    // Win on the spot if the side to move can, otherwise block the other side's fives; all of
+    // them, since which one comes first on the board depends on the orientation
+    const bool aiToMove = boardManager.sideToMove() == _color;
+    BoardPosition forced[BoardManager::CELL_COUNT];
+    if (collectThreatCells<Size>((aiToMove ? ownMasks : opponentMasks).win, forced, 1)) {
+        if (threatCount) *threatCount = 1;
+        return {forced[0]};
+    }
+    const int blocks = collectThreatCells<Size>((aiToMove ? opponentMasks : ownMasks).win, forced,
+                                                BoardManager::CELL_COUNT);
+    if (blocks > 0) {
+        if (threatCount) *threatCount = blocks;
+        return {forced, forced + blocks};
+    }
+
     for (const auto& pos : boardManager.getCandidateMoves()) {
-        if (wouldWin(boardManager, pos, _color) ||
-            wouldWin(boardManager, pos, getOpponent(_color))) {
-            // Prioritize immediate winning/blocking moves
-            return {pos};
-        } else if (posesThreat(boardManager, pos, _color) ||
-                   posesThreat(boardManager, pos, getOpponent(_color))) {
+        if (ownMasks.threatens(pos) || opponentMasks.threatens(pos)) {
             threatMoves.push_back(pos);
         } else {
             moves.push_back(pos);
         }
     }
 
-    // Prefer center control
-    std::sort(moves.begin(), moves.end(), [&](const BoardPosition& a, const BoardPosition& b) {
-        return boardManager.centerManhattanDistance[a.row][a.col] <
-               boardManager.centerManhattanDistance[b.row][b.col];
-    });
+    if (context) {
+        // Killer moves first, then the history heuristic, then prefer center control
+        const auto& killers = context->killers[boardManager.movesPlayed()];
+        const auto& history = context->history[boardManager.sideToMove() == BLACK ? 0 : 1];
+        auto orderKey = [&](const BoardPosition& pos) {
+            if (pos == killers[0]) return 1 << 30;
+            if (pos == killers[1]) return 1 << 29;
+            return history[pos.row][pos.col] * 64 - boardManager.centerManhattanDistance[pos.row][pos.col];
+        };
+        auto byOrderKey = [&](const BoardPosition& a, const BoardPosition& b) {
+            return orderKey(a) > orderKey(b);
+        };
+        std::sort(threatMoves.begin(), threatMoves.end(), byOrderKey);
+        std::sort(moves.begin(), moves.end(), byOrderKey);
+    } else {
+        // Prefer center control
+        std::sort(moves.begin(), moves.end(), [&](const BoardPosition& a, const BoardPosition& b) {
+            return boardManager.centerManhattanDistance[a.row][a.col] <
+                   boardManager.centerManhattanDistance[b.row][b.col];
+        });
+    }
 
+    size_t threats = threatMoves.size();
     threatMoves.insert(threatMoves.end(), moves.begin(), moves.end());
+
+    // In a position that maps onto itself, moves that are images of each other score the
+    // same; keep the first of each. Common right after the opening move.
+    const int symmetries = SYMMETRIC_SEARCH ? boardManager.positionSymmetries() & ~1 : 0;
+    if (symmetries) {
+        std::bitset<BoardManager::CELL_COUNT> covered;
+        const size_t allThreats = threats;
+        threats = 0;
+        auto kept = threatMoves.begin();
+        for (size_t i = 0; i < threatMoves.size(); ++i) {
+            const BoardPosition pos = threatMoves[i];
+            if (covered[pos.row * Size + pos.col]) continue;
+            if (i < allThreats) ++threats;
+            for (int symmetry = 0; symmetry < BoardManager::SYMMETRIES; ++symmetry) {
+                if (symmetries >> symmetry & 1) {
+                    const BoardPosition image = BoardManager::transform(pos, symmetry);
+                    covered[image.row * Size + image.col] = true;
+                }
+            }
+            *kept++ = pos;
+        }
+        threatMoves.erase(kept, threatMoves.end());
+    }
+    if (threatCount) *threatCount = threats;
     return threatMoves;
 }
 
-GomokuAI::SequenceSummary GomokuAI::evaluateForPlayerAtPos(
+template <int Size>
+SequenceSummary BasicGomokuAI<Size>::evaluateForPlayerAtPos(
     const BoardManager& boardManager,
     const char player,
     const int row,
@@ -176,266 +570,382 @@ GomokuAI::SequenceSummary GomokuAI::evaluateForPlayerAtPos(
         return summary;
     }
 
-    const int directions[4][2] = {
-        {0, 1},
-        {1, 0},
-        {1, 1},
-        {1, -1}
-    };
+    for (int direction = 0; direction < BoardManager::LINE_DIRECTIONS; ++direction) {
+        const auto view = boardManager.lineThrough(player, direction, row, col);
 
-    for (const auto& dir : directions) {
-        const int prevRow = row - dir[0];
-        const int prevCol = col - dir[1];
-
-        if (isInsideBoard(prevRow, prevCol) &&
-            boardManager.getCell(prevRow, prevCol) == player) {
+        if (view.index > 0 && (view.stones >> (view.index - 1) & 1)) {
             continue; // Already counted as part of a preceding segment
         }
-
-        int length = 1;
-        int nextRow = row + dir[0];
-        int nextCol = col + dir[1];
-
-        while (
-            isInsideBoard(nextRow, nextCol) &&
-            boardManager.getCell(nextRow, nextCol) == player
-        ) {
-            ++length;
-            nextRow += dir[0];
-            nextCol += dir[1];
-        }
-
-        const bool openStart = isInsideBoard(prevRow, prevCol) && 
-                                boardManager.getCell(prevRow, prevCol) == EMPTY;
-        const bool openEnd = isInsideBoard(nextRow, nextCol) &&
-                                boardManager.getCell(nextRow, nextCol) == EMPTY;
-        const int openSides = static_cast<int>(openStart) + static_cast<int>(openEnd);
-        summary.score += sequenceScore(length, openSides);
-
-        if (length >= 5) {
-            if (openSides > 0) {
-                summary.openFours += 1;
-            }
-            continue;
+        if (view.index > 1 && (view.empty >> (view.index - 1) & 1) && (view.stones >> (view.index - 2) & 1)) {
+            continue; // Past a single gap, so part of the segment that starts before it
         }
 
-        if (length == 4) {
-            if (openSides == 2) {
-                summary.openFours += 1;
-            } else if (openSides == 1) {
-                summary.semiOpenFours += 1;
-            }
-        } else if (length == 3) {
-            if (openSides == 2) {
-                summary.openThrees += 1;
-            } else if (openSides == 1) {
-                summary.semiOpenThrees += 1;
-            }
-        }
+        summary += segmentPattern(view.stones, view.empty, view.index);
     }
 
     return summary;
 }
 
-std::pair<GomokuAI::SequenceSummary, GomokuAI::SequenceSummary> 
-GomokuAI::evaluateSequences(const BoardManager& boardManager) const {
-    SequenceSummary playerSummary;
-    SequenceSummary opponentSummary;
-
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            playerSummary += evaluateForPlayerAtPos(boardManager, _color, row, col);
-            opponentSummary += evaluateForPlayerAtPos(boardManager, getOpponent(_color), row, col);
-        }
-    }
-
-    return {playerSummary, opponentSummary};
-}
-
-int GomokuAI::centerControlBias(const BoardManager& boardManager, const char player) const {
-    const int center = BOARD_SIZE / 2;
-    int score = 0;
-
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            if (boardManager.getCell(row, col) != player) {
-                continue;
-            }
-
-            const int distance = std::abs(center - row) + std::abs(center - col);
-            int contribution = std::max(1, BOARD_SIZE - distance);
-            score += contribution;
-        }
-    }
-
-    return score;
-}
-
-int GomokuAI::evaluate(const BoardManager &boardManager, const char player) const {
+template <int Size>
+int BasicGomokuAI<Size>::evaluate(const BoardManager &boardManager, const char player) const {
     const char opponent = getOpponent(player);
-    const auto [playerSummary, opponentSummary] = evaluateSequences(boardManager);
+    const SequenceSummary& playerSummary = boardManager.sequenceSummary(player);
+    const SequenceSummary& opponentSummary = boardManager.sequenceSummary(opponent);
 
     if (playerSummary.openFours > 0) {
-        return 400000 + playerSummary.openFours * 2000;
+        return _weights.openFour + playerSummary.openFours * _weights.extraOpenFour;
     }
     if (opponentSummary.openFours > 0) {
-        return -400000 - opponentSummary.openFours * 2000;
+        return -_weights.openFour - opponentSummary.openFours * _weights.extraOpenFour;
     }
 
     int score = playerSummary.score - opponentSummary.score;
 
-    const int openThreeBonus = 15000;
-    score += openThreeBonus * (playerSummary.openThrees - opponentSummary.openThrees);
+    score += _weights.openThree * (playerSummary.openThrees - opponentSummary.openThrees);
 
-    const int doubleThreeBonus = 60000;
     if (playerSummary.openThrees >= 2) {
-        score += doubleThreeBonus;
+        score += _weights.doubleOpenThree;
     }
     if (opponentSummary.openThrees >= 2) {
-        score -= doubleThreeBonus;
+        score -= _weights.doubleOpenThree;
     }
 
-    const int semiOpenThreeBonus = 4000;
-    score += semiOpenThreeBonus * (playerSummary.semiOpenThrees - opponentSummary.semiOpenThrees);
+    score += _weights.semiOpenThree * (playerSummary.semiOpenThrees - opponentSummary.semiOpenThrees);
 
-    const int semiOpenFourBonus = 20000;
-    score += semiOpenFourBonus * (playerSummary.semiOpenFours - opponentSummary.semiOpenFours);
+    score += _weights.semiOpenFour * (playerSummary.semiOpenFours - opponentSummary.semiOpenFours);
 
-    const int centerWeight = 2;
-    const int centerScore = centerControlBias(boardManager, player) -
-                            centerControlBias(boardManager, opponent);
-    score += centerWeight * centerScore;
+    const int centerScore = boardManager.centerBias(player) - boardManager.centerBias(opponent);
+    score += _weights.center * centerScore;
 
     return score;
 }
 
-std::pair<int, BoardPosition> GomokuAI::minimaxAlphaBeta(
+template <int Size>
+std::pair<int, BoardPosition> BasicGomokuAI<Size>::principalVariationSearch(
+    SearchContext& context,
     BoardManager& boardManager,
-    int depth,
-    bool isMaximizing,
+    const int depth,
     int alpha,
     int beta
 ) const {
-    if (QThread::currentThread()->isInterruptionRequested()) {
+    ++context.nodes;
+    if (context.nodes % TIME_CHECK_INTERVAL == 0 &&
+        (stopRequested.load(std::memory_order_relaxed) ||
+         (_timeBudgetMs > 0 && std::chrono::steady_clock::now() >= deadline))) {
+        // stopRequested is polled too in case requestStop() raced the reset in getBestMove()
+        searchStop.store(true, std::memory_order_relaxed);
+    }
+    if (searchAborted(context)) {
         return {0, {-1, -1}};
     }
-    char winner = boardManager.checkWinner();
-    if (depth == 0 || winner != EMPTY) {
-        if (winner == _color) {
-            // Prefer immediate wins
-            return {std::numeric_limits<int>::max() / 2 + 10000, {}};
-        } else if (winner == getOpponent(_color)) {
-            return {std::numeric_limits<int>::min() / 2 - 10000, {}};
+    const bool afterNullMove = context.afterNullMove;
+    context.afterNullMove = false;
+
+    // Scores are from the perspective of the side to move
+    const char sideToMove = boardManager.sideToMove();
+    const char winner = boardManager.checkWinner();
+    if (winner != EMPTY) {
+        // Only the player who just moved can have won. Prefer immediate wins.
+        return {winner == sideToMove ? WIN_SCORE + 10000 : -WIN_SCORE - 10000, {}};
+    }
+    if (depth == 0) {
+        // A win the static evaluation can't see
+        if (_vcfAtLeaves && context.leafVcf.findWin(boardManager, sideToMove).row >= 0) {
+            return {WIN_SCORE, {}};
+        }
+        if (_quiescence) {
+            context.quiescenceNodes = QUIESCENCE_MAX_NODES;
+            return {quiescenceSearch(context, boardManager, 0, alpha, beta), {}};
         }
-        // Always evaluate from the AI's perspective
-        return {evaluate(boardManager, _color), {}};
+        // The evaluation itself is always from the AI's perspective
+        const int score = evaluate(boardManager, _color);
+        return {sideToMove == _color ? score : -score, {}};
     }
 
-    BoardPosition bestMove;
-    auto moves = candidateMoves(boardManager);
-    
-    if (isMaximizing) {
-        int maxEval = std::numeric_limits<int>::min();
-
-        for (const auto& pos : moves) {
-            boardManager.makeMove(pos);
-            auto [eval, _] = minimaxAlphaBeta(boardManager, depth - 1, false, alpha, beta);
-            boardManager.undoMove();
-            
-            if (eval > maxEval) {
-                maxEval = eval;
-                bestMove = pos;
+    // Narrow the window with a cached result; a deep enough exact score ends the search here
+    const auto canonical = tableKey(boardManager);
+    const uint64_t key = canonical.first;
+    const int symmetry = canonical.second;
+    TranspositionTable::Entry cached;
+    BoardPosition cachedMove{-1, -1};
+    if (transpositionTable.probe(key, cached, context.tableCounts)) {
+        if (cached.bestMove.row >= 0) {
+            cachedMove = BoardManager::inverseTransform(cached.bestMove, symmetry);
+        }
+        if (cached.depth >= depth) {
+            if (cached.bound == TranspositionTable::Bound::Exact) {
+                return {cached.score, cachedMove};
             }
-            
-            alpha = std::max(alpha, eval);
-            // Prune: the minimizing parent already has a better option (beta),
-            // so it won't choose this branch regardless of remaining moves
-            if (beta <= alpha) {
-                break;
+            if (cached.bound == TranspositionTable::Bound::Lower) {
+                alpha = std::max(alpha, cached.score);
+            } else {
+                beta = std::min(beta, cached.score);
+            }
+            if (alpha >= beta) {
+                return {cached.score, cachedMove};
             }
         }
-        
-        return {maxEval, bestMove};
-    } else {
-        int minEval = std::numeric_limits<int>::max();
-
-        for (const auto& pos : moves) {
-            boardManager.makeMove(pos);
-            auto [eval, _] = minimaxAlphaBeta(boardManager, depth - 1, true, alpha, beta);
-            boardManager.undoMove();
-            
-            if (eval < minEval) {
-                minEval = eval;
-                bestMove = pos;
+    }
+    const int windowAlpha = alpha;
+    const int windowBeta = beta;
+
+    // Null move: if even passing holds beta at reduced depth, some real move will too. Not
+    // near decided scores, and not when the opponent could answer the pass with a four or a
+    // three: an open three left alone becomes an open four, which the reduced search misses.
+    if (_nullMovePruning && !afterNullMove && depth > NULL_MOVE_REDUCTION && depth < context.rootDepth &&
+        beta < WIN_SCORE && beta > -WIN_SCORE) {
+        const int evaluation = evaluate(boardManager, _color);
+        const int standPat = sideToMove == _color ? evaluation : -evaluation;
+        const ThreatMasks opponentMasks = computeThreatMasks(boardManager, getOpponent(sideToMove), true);
+        uint32_t forcing = 0;
+        for (int row = 0; row < Size; ++row) {
+            forcing |= opponentMasks.win[row] | opponentMasks.four[row] | opponentMasks.threat[row];
+        }
+        if (standPat >= beta && forcing == 0) {
+            boardManager.makeNullMove();
+            context.afterNullMove = true;
+            const int score = -principalVariationSearch(
+                context, boardManager, depth - 1 - NULL_MOVE_REDUCTION, -beta, -beta + 1
+            ).first;
+            context.afterNullMove = false;
+            boardManager.undoNullMove();
+            if (score >= beta && !searchAborted(context)) {
+                return {std::min(score, WIN_SCORE - 1), cachedMove};
             }
-            
-            beta = std::min(beta, eval);
-            // Prune: the maximizing parent already has a better option (alpha),
-            // so it won't choose this branch regardless of remaining moves
-            if (beta <= alpha) {
-                break;
+        }
+    }
+
+    size_t threatMoveCount = 0;
+    auto moves = candidateMoves(boardManager, &context, &threatMoveCount);
+    if (moves.empty()) {
+        // Full board
+        return {0, {}};
+    }
+
+    // Search the cached best move first. A quiet one pushes every threat move back by one.
+    const auto cachedMoveIt = std::find(moves.begin(), moves.end(), cachedMove);
+    if (cachedMoveIt != moves.end()) {
+        if (static_cast<size_t>(cachedMoveIt - moves.begin()) >= threatMoveCount) {
+            ++threatMoveCount;
+        }
+        std::rotate(moves.begin(), cachedMoveIt, cachedMoveIt + 1);
+    }
+
+    // Lazy SMP helpers start from different root moves so the threads spread over the tree
+    if (_searchMode == SearchMode::LazySMP && depth == context.rootDepth && context.threadIndex > 0 &&
+        moves.size() > 1) {
+        const auto offset = static_cast<std::ptrdiff_t>(context.threadIndex % moves.size());
+        std::rotate(moves.begin(), moves.begin() + offset, moves.end());
+    }
+
+    // YBWC splits a node only once its first move is searched, and not near the leaves
+    const bool canSplit = _searchMode == SearchMode::YoungBrothersWait && threadCount > 1 &&
+                          depth >= YBWC_MIN_SPLIT_DEPTH && moves.size() > 1;
+
+    int bestScore = -INF;
+    BoardPosition bestMove = moves.front();
+    const auto& killers = context.killers[boardManager.movesPlayed()];
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const BoardPosition pos = moves[i];
+        // Quiet moves this far down the order rarely matter; a shallower look settles most
+        const bool reduced = _lateMoveReductions && depth >= LMR_MIN_DEPTH && i >= LMR_FULL_DEPTH_MOVES &&
+                             i >= threatMoveCount && pos != killers[0] && pos != killers[1];
+        boardManager.makeMove(pos);
+        int score;
+        if (i == 0) {
+            score = -principalVariationSearch(context, boardManager, depth - 1, -beta, -alpha).first;
+        } else {
+            if (reduced) {
+                score = -principalVariationSearch(
+                    context, boardManager, depth - 1 - LMR_REDUCTION, -alpha - 1, -alpha
+                ).first;
+            }
+            // With good ordering the first move is best, so later ones only need to be proven
+            // no better; a null window does that cheaply. Re-search only the ones that fail high.
+            if (!reduced || score > alpha) {
+                score = -principalVariationSearch(context, boardManager, depth - 1, -alpha - 1, -alpha).first;
+                if (score > alpha && score < beta) {
+                    score = -principalVariationSearch(context, boardManager, depth - 1, -beta, -alpha).first;
+                }
             }
         }
-        
-        return {minEval, bestMove};
+        boardManager.undoMove();
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = pos;
+        }
+        alpha = std::max(alpha, score);
+        // Prune: the opponent already has a better option elsewhere,
+        // so it won't allow this position regardless of remaining moves
+        if (alpha >= beta) {
+            recordCutoff(context, boardManager, pos, depth);
+            break;
+        }
+
+        if (canSplit && i == 0) {
+            searchYoungerBrothers(context, boardManager, depth, moves, alpha, beta, bestScore, bestMove);
+            break;
+        }
+    }
+
+    // Record the result unless the search was aborted and the score is meaningless
+    if (!searchAborted(context)) {
+        TranspositionTable::Bound bound = TranspositionTable::Bound::Exact;
+        if (bestScore <= windowAlpha) {
+            bound = TranspositionTable::Bound::Upper;
+        } else if (bestScore >= windowBeta) {
+            bound = TranspositionTable::Bound::Lower;
+        }
+        transpositionTable.store(
+            key, depth, bound, bestScore, BoardManager::transform(bestMove, symmetry), context.tableCounts
+        );
+    }
+
+    return {bestScore, bestMove};
+}
+
+template <int Size>
+int BasicGomokuAI<Size>::quiescenceSearch(
+    SearchContext& context,
+    BoardManager& boardManager,
+    const int ply,
+    int alpha,
+    const int beta,
+    const ThreatMasks* threatBefore
+) const {
+    ++context.nodes;
+    const char sideToMove = boardManager.sideToMove();
+    const char opponent = sideToMove == BLACK ? WHITE : BLACK;
+
+    // A five for the side to move wins; two for the opponent can't both be blocked
+    const ThreatMasks own = computeThreatMasks(boardManager, sideToMove, true);
+    BoardPosition fives[2];
+    if (collectThreatCells<Size>(own.win, fives, 1) > 0) {
+        return WIN_SCORE;
+    }
+    const int opponentFives = collectThreatCells<Size>(computeThreatMasks(boardManager, opponent).win, fives, 2);
+    if (opponentFives == 2) {
+        return -WIN_SCORE;
+    }
+
+    const int evaluation = evaluate(boardManager, _color);
+    const int standPat = sideToMove == _color ? evaluation : -evaluation;
+    if (ply >= QUIESCENCE_MAX_PLY || context.quiescenceNodes <= 0 || searchAborted(context)) {
+        return standPat;
+    }
+    --context.quiescenceNodes;
+
+    BoardPosition moves[BoardManager::CELL_COUNT];
+    int count = 0;
+    bool forced = true;
+    if (opponentFives == 1) {
+        moves[count++] = fives[0];
+    } else if (threatBefore) {
+        count = BasicVCTSolver<Size>::threatReplies(boardManager, opponent, *threatBefore, moves);
+    }
+    if (count == 0) {
+        // Nothing to answer: the side to move may settle for the evaluation or attack
+        forced = false;
+        uint32_t attacks[THREAT_KERNEL_MAX_SIZE] = {};
+        for (int row = 0; row < Size; ++row) {
+            attacks[row] = _quiescenceThrees ? own.four[row] | own.threat[row] : own.four[row];
+        }
+        count = collectThreatCells<Size>(attacks, moves, BoardManager::CELL_COUNT);
+    }
+
+    int bestScore = forced ? -INF : standPat;
+    if (!forced) {
+        if (standPat >= beta) {
+            return standPat;
+        }
+        alpha = std::max(alpha, standPat);
     }
+    for (int i = 0; i < count; ++i) {
+        const bool three = !forced && !own.makesFour(moves[i]);
+        boardManager.makeMove(moves[i]);
+        const int score = -quiescenceSearch(context, boardManager, ply + 1, -beta, -alpha, three ? &own : nullptr);
+        boardManager.undoMove();
+
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
+        }
+    }
+    return bestScore;
 }
 
-BoardPosition GomokuAI::minimaxAlphaBetaRootParallel(
+template <int Size>
+std::pair<int, BoardPosition> BasicGomokuAI<Size>::rootSplitSearch(
     BoardManager& boardManager,
-    int depth
+    int depth,
+    BoardPosition firstMove,
+    int alpha,
+    int beta
 ) const {
-    // We parallelize only the root level of the minimax tree.
+    // We parallelize only the root level of the search tree.
     // Divide the possible moves into chunks, where each chunk is processed in parallel.
     // After processing a chunk, update a global alpha based on the results from that chunk.
     // This to some extent preserves pruning: pruning is still valid across chunks;
     // But within each chunk, no pruning occurs.
 
-    if (QThread::currentThread()->isInterruptionRequested()) {
-        return {-1, -1};
+    if (searchAborted()) {
+        return {0, {-1, -1}};
     }
 
-    BoardPosition bestMove;
+    BoardPosition bestMove{-1, -1};
+    int bestScore = -INF;
     auto moves = candidateMoves(boardManager);
-    // Each chunk should have threadCount moves to maximize parallelism
-    auto chunks = splitIntoChunks(moves, threadCount);
+    const auto firstMoveIt = std::find(moves.begin(), moves.end(), firstMove);
+    if (firstMoveIt != moves.end()) {
+        std::rotate(moves.begin(), firstMoveIt, firstMoveIt + 1);
+    }
+    // Each chunk should have as many moves as threads to maximize parallelism
+    auto chunks = splitIntoChunks(moves, std::min(threadCount, ROOT_SPLIT_MAX_THREADS));
 
-    int globalAlpha = std::numeric_limits<int>::min();
+    int globalAlpha = alpha;
 
     for (const auto& chunk : chunks) {
         auto results = QtConcurrent::blockingMapped(
             &threadPool,
             chunk,
-            [this, &boardManager, depth, globalAlpha](const BoardPosition& pos) {
+            [this, &boardManager, depth, globalAlpha, beta](const BoardPosition& pos) {
                 BoardManager simulatedBoard = boardManager;
                 simulatedBoard.makeMove(pos);
-                auto [eval, _] = minimaxAlphaBeta(
+                // Each task starts with a fresh context; root-split tasks don't share a thread.
+                // It gets the full root depth, so null move works below the root moves too.
+                SearchContext context{0, depth};
+                context.clearKillers();
+                const int score = -principalVariationSearch(
+                    context,
                     simulatedBoard,
                     depth - 1,
-                    false,
-                    globalAlpha,
-                    std::numeric_limits<int>::max()
-                );
-                return std::make_pair(eval, pos);
+                    -beta,
+                    -globalAlpha
+                ).first;
+                flushCounts(context);
+                return std::make_pair(score, pos);
             }
         );
 
-        // Find the best move in this chunk
-        int chunkMaxEval = std::numeric_limits<int>::min();
-        BoardPosition chunkBestMove;
-        for (const auto& [eval, pos] : results) {
-            if (eval > chunkMaxEval) {
-                chunkMaxEval = eval;
-                chunkBestMove = pos;
+        // Find the best move in this chunk, and update global alpha for the next one
+        for (const auto& [score, pos] : results) {
+            if (score > bestScore) {
+                bestScore = score;
+                bestMove = pos;
             }
         }
-
-        // Update global alpha for next chunk
-        if (chunkMaxEval > globalAlpha) {
-            globalAlpha = chunkMaxEval;
-            bestMove = chunkBestMove;
+        globalAlpha = std::max(globalAlpha, bestScore);
+        if (globalAlpha >= beta) {
+            break;
         }
     }
 
-    return bestMove;
+    return {bestScore, bestMove};
 }
+
+template class BasicGomokuAI<15>;
+template class BasicGomokuAI<19>;
+template class BasicGomokuAI<20>;
@@ -6,40 +6,162 @@
 
 #include "BoardManager.h"
 #include "Constants.h"
+#include "OpeningBook.h"
+#include "ProofNumberSolver.h"
+#include "TranspositionTable.h"
+#include "VCFSolver.h"
+#include "VCTSolver.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <future>
 #include <QThread>
 #include <QtConcurrent/QtConcurrent>
 #include <QThreadPool>
 
-class GomokuAI {
+// How getBestMove() spreads a search over threads
+enum class SearchMode {
+    // Single-threaded
+    Sequential,
+    // Root moves are searched in chunks of parallel tasks, with a barrier after each chunk
+    RootSplit,
+    // Every thread searches the whole tree; they diverge through depth offsets and root move
+    // order and share work through the transposition table
+    LazySMP,
+    // Young Brothers Wait: once a node's first move is searched, idle threads steal the
+    // remaining siblings; a cutoff aborts every thread still working below the node
+    YoungBrothersWait
+};
+
+// Lets the micro-benchmarks (Tests/GomokuBenchmarks.cpp) time the private hot paths
+struct GomokuAIBenchmarkAccess;
+// Lets the correctness checks (Tests/GomokuAIOverHeadTests.cpp) reach the search internals
+struct GomokuAITestAccess;
+
+// Bonuses evaluate() adds on top of the line pattern scores, per pattern the player has
+// minus the opponent's. The defaults are the tuned values the app plays with.
+struct EvaluationWeights {
+    int openFour = 400000;       // Any open four decides the evaluation
+    int extraOpenFour = 2000;    // Per open four
+    int openThree = 15000;
+    int doubleOpenThree = 60000; // Once for two or more open threes
+    int semiOpenThree = 4000;
+    int semiOpenFour = 20000;
+    int center = 2;              // Per point of BoardManager::centerBias()
+};
+
+template <int Size>
+class BasicGomokuAI {
 public:
-    explicit GomokuAI(char color, int maxDepth = MAX_DEPTH);
+    using BoardManager = BasicBoardManager<Size>;
+
+    explicit BasicGomokuAI(char color, int maxDepth = MAX_DEPTH);
 
     BoardPosition getBestMove(const BoardManager& boardManager) const;
 
-    void setColor(char c) { _color = c; }
+    // Cached scores are relative to the AI's color, so changing it drops the table
+    void setColor(char c) {
+        _color = c;
+        transpositionTable.clear();
+    }
     [[nodiscard]] char getColor() const { return _color; }
     void setMaxDepth(int depth) { _maxDepth = depth; }
     [[nodiscard]] int getMaxDepth() const { return _maxDepth; }
 
-    struct SequenceSummary {
-        int score = 0;
-        int openThrees = 0;
-        int semiOpenThrees = 0;
-        int openFours = 0;
-        int semiOpenFours = 0;
-
-        SequenceSummary& operator+=(const SequenceSummary& other) {
-            score += other.score;
-            openThrees += other.openThrees;
-            semiOpenThrees += other.semiOpenThrees;
-            openFours += other.openFours;
-            semiOpenFours += other.semiOpenFours;
-            return *this;
-        }
-    };
+    // With a budget, getBestMove() deepens 1, 2, 3... (up to MAX_ITERATIVE_DEPTH) until the time
+    // runs out and plays the move of the deepest finished iteration. 0 searches exactly maxDepth.
+    void setTimeBudget(int milliseconds) { _timeBudgetMs = milliseconds; }
+    [[nodiscard]] int getTimeBudget() const { return _timeBudgetMs; }
+
+    // Not safe to call while a search is running
+    void setTranspositionTableSize(size_t sizeMB) { transpositionTable.resize(sizeMB); }
+    [[nodiscard]] TranspositionTable::Stats transpositionTableStats() const { return transpositionTable.stats(); }
+
+    // Nodes visited by the most recent getBestMove() call
+    [[nodiscard]] uint64_t lastSearchNodes() const { return nodesSearched.load(std::memory_order_relaxed); }
+    // Not safe to call while a search is running
+    void setSearchMode(SearchMode mode) { _searchMode = mode; }
+    [[nodiscard]] SearchMode getSearchMode() const { return _searchMode; }
+    void setThreadCount(int count) {
+        threadCount = std::max(1, count);
+        threadPool.setMaxThreadCount(threadCount);
+    }
+    [[nodiscard]] int getThreadCount() const { return threadCount; }
+
+    // Also look for a win by continuous fours at every leaf. Finds deeper wins at a large
+    // cost per leaf, so it is off by default.
+    void setVCFAtLeaves(bool enabled) { _vcfAtLeaves = enabled; }
+    [[nodiscard]] bool getVCFAtLeaves() const { return _vcfAtLeaves; }
+
+    // Before searching, getBestMove() looks for a forced win at the root with fours alone,
+    // then with open threes as well. The second solver gets a tenth of the time budget, at
+    // most VCT_TIME_LIMIT_MS; in fixed-depth mode its limit scales with the depth instead.
+    // On by default; turn it off to time the search alone.
+    void setForcedWinPreCheck(bool enabled) { _forcedWinPreCheck = enabled; }
+    [[nodiscard]] bool getForcedWinPreCheck() const { return _forcedWinPreCheck; }
+
+    // Cached scores depend on the weights, so changing them drops the table
+    void setEvaluationWeights(const EvaluationWeights& weights) {
+        _weights = weights;
+        transpositionTable.clear();
+    }
+    [[nodiscard]] const EvaluationWeights& getEvaluationWeights() const { return _weights; }
+
+    // Search quiet moves late in the order at reduced depth first, re-searching the ones that
+    // beat alpha at full depth
+    void setLateMoveReductions(bool enabled) { _lateMoveReductions = enabled; }
+    [[nodiscard]] bool getLateMoveReductions() const { return _lateMoveReductions; }
+    // Let the side to move pass at reduced depth and cut off if it still reaches beta. Only
+    // tried when the opponent can't make a four; off by default as it may miss slow attacks.
+    void setNullMovePruning(bool enabled) { _nullMovePruning = enabled; }
+    [[nodiscard]] bool getNullMovePruning() const { return _nullMovePruning; }
 
+    // At the depth horizon, keep reading forcing moves (fours and their blocks) before
+    // evaluating, so a leaf in the middle of an attack isn't scored as if it were quiet. With
+    // threes as well, open threes are extended too and must be answered.
+    void setQuiescenceSearch(bool enabled) { _quiescence = enabled; }
+    [[nodiscard]] bool getQuiescenceSearch() const { return _quiescence; }
+    void setQuiescenceThrees(bool enabled) { _quiescenceThrees = enabled; }
+    [[nodiscard]] bool getQuiescenceThrees() const { return _quiescenceThrees; }
+
+    // Positions in the book are answered from it without searching. The file stays mapped
+    // until another book is loaded or the AI is destroyed.
+    bool loadOpeningBook(const QString& path) { return openingBook.open(path); }
+    [[nodiscard]] bool hasOpeningBook() const { return openingBook.isOpen(); }
+
+    // Use the proof-number solver instead of the bounded VCT for the threat-space check before
+    // the full search; the search itself is unchanged. It settles more positions in the same
+    // time but allocates its own table, so it is off by default. GomokuLabeler runs the same
+    // solver offline on recorded positions.
+    void setProofNumberSearch(bool enabled) {
+        proofSolver = enabled ? std::make_unique<BasicProofNumberSolver<Size>>() : nullptr;
+    }
+    [[nodiscard]] bool getProofNumberSearch() const { return proofSolver != nullptr; }
+
+    // Makes a running getBestMove() return within a few nodes with the best move found so far.
+    // Until clearStop(), any started later finds the flag already set and returns at once with
+    // its first candidate move, unsearched; only book moves are still real answers. Safe to
+    // call from another thread, e.g. to end pondering or to cancel a search before shutting down.
+    void requestStop() {
+        stopRequested.store(true, std::memory_order_relaxed);
+        searchStop.store(true, std::memory_order_relaxed);
+    }
+    void clearStop() { stopRequested.store(false, std::memory_order_relaxed); }
+
+    // The move the last searches expect the side to move to play here, read from the
+    // transposition table; {-1, -1} if they didn't get this far
+    [[nodiscard]] BoardPosition predictedMove(const BoardManager& boardManager) const;
+
+    // Depth of the deepest search the last getBestMove() finished, 0 if none did, including
+    // book moves, forced wins and forced replies
+    [[nodiscard]] int lastSearchDepth() const { return completedDepth; }
+
+    using SequenceSummary = ::SequenceSummary;
 
     [[nodiscard]] SequenceSummary evaluateForPlayerAtPos(
         const BoardManager& boardManager,
@@ -49,16 +171,173 @@ public:
     ) const;
 
 private:
+    friend struct GomokuAIBenchmarkAccess;
+    // Lets the correctness checks (Tests/GomokuAIOverHeadTests.cpp) reach the search internals
+    friend struct GomokuAITestAccess;
+
     char _color; // BLACK(1) or WHITE(2)
     int _maxDepth;
+    int _timeBudgetMs = 0;
+    bool _vcfAtLeaves = false;
+    bool _forcedWinPreCheck = true;
+    bool _quiescence = true;
+    bool _quiescenceThrees = false;
+    EvaluationWeights _weights;
+    bool _lateMoveReductions = true;
+    bool _nullMovePruning = false;
+    mutable BasicVCFSolver<Size> vcfSolver;
+    mutable BasicVCTSolver<Size> vctSolver;
+    std::unique_ptr<BasicProofNumberSolver<Size>> proofSolver;
+    BasicOpeningBook<Size> openingBook;
+    SearchMode _searchMode = ENABLE_PARALLELIZATION ? SearchMode::LazySMP : SearchMode::Sequential;
+
+    // Negamax scores live in [-INF, INF] so they can always be negated
+    static constexpr int INF = std::numeric_limits<int>::max();
+    // Scores at or beyond this magnitude are decided games
+    static constexpr int WIN_SCORE = std::numeric_limits<int>::max() / 2;
+    // Share table entries between symmetric positions and skip symmetric duplicate moves.
+    // Only sound when the evaluation is symmetric too, which needs a center cell: the center
+    // bias measures distance to (Size / 2, Size / 2). The overhead tests check evaluate()
+    // agrees on all eight images of a position.
+    static constexpr bool SYMMETRIC_SEARCH = Size % 2 == 1;
+    // Transposition table key of a position and the symmetry its stored moves are expressed in
+    [[nodiscard]] static std::pair<uint64_t, int> tableKey(const BoardManager& boardManager) {
+        return SYMMETRIC_SEARCH ? boardManager.canonicalHash() : std::make_pair(boardManager.hash(), 0);
+    }
+    // Half-width of the first root window around the previous iteration's score
+    static constexpr int ASPIRATION_WINDOW = 4000;
 
-    // Cap the thread count to ensure pruning efficiency
-    int threadCount = std::min(QThread::idealThreadCount(), 12);
+    // Reading the clock at every node is too slow; poll it, and stopRequested, once per this
+    // many nodes
+    static constexpr uint64_t TIME_CHECK_INTERVAL = 1024;
+    mutable std::chrono::steady_clock::time_point deadline;
+    // Stop token of the current search, shared by every thread and solver working on it and
+    // read at each node. Set when the time is up or by requestStop().
+    mutable std::atomic<bool> searchStop{false};
+    std::atomic<bool> stopRequested{false};
+    // Set when the main thread finishes an iteration; Lazy SMP and YBWC helpers then stop
+    mutable std::atomic<bool> helpersStop{false};
+    mutable int completedDepth = 0;
+
+    int threadCount = QThread::idealThreadCount();
+    // Root splitting loses pruning inside each chunk, so it doesn't use more threads than this
+    static constexpr int ROOT_SPLIT_MAX_THREADS = 12;
+    // Shallower subtrees are cheaper to search than to hand to another thread
+    static constexpr int YBWC_MIN_SPLIT_DEPTH = 3;
+    // Late move reductions: the first moves searched in full, the depth from which quiet moves
+    // are reduced, and by how much
+    static constexpr size_t LMR_FULL_DEPTH_MOVES = 4;
+    static constexpr int LMR_MIN_DEPTH = 3;
+    static constexpr int LMR_REDUCTION = 2;
+    // Null-move pruning: extra depth taken off the pass, on top of the ply itself
+    static constexpr int NULL_MOVE_REDUCTION = 2;
     // Use mutable to allow const methods to use the thread pool
     mutable QThreadPool threadPool;
 
+    // Shared by every worker in threadPool and kept between moves
+    mutable TranspositionTable transpositionTable;
+    mutable std::atomic<uint64_t> nodesSearched{0};
+
     [[nodiscard]] static char getOpponent(char player) { return (player == BLACK) ? WHITE : BLACK; }
 
+    // A YBWC node whose remaining moves any thread may pick up
+    struct SplitPoint {
+        // Position at the node, for helpers to copy
+        BoardManager board;
+        int depth;
+        int beta;
+        std::vector<BoardPosition> moves;
+        // Enclosing split point of the owner; a cutoff there aborts this one too
+        const SplitPoint* parent;
+
+        std::atomic<size_t> nextMove{1};
+        std::atomic<int> helpers{0};
+        std::atomic<bool> cutoff{false};
+
+        // Guarded by mutex
+        std::mutex mutex;
+        int alpha;
+        int bestScore;
+        BoardPosition bestMove;
+
+        [[nodiscard]] bool cutoffInChain() const {
+            for (const SplitPoint* point = this; point; point = point->parent) {
+                if (point->cutoff.load(std::memory_order_relaxed)) return true;
+            }
+            return false;
+        }
+    };
+
+    // Split points a thread has opened, oldest (and largest) first
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<SplitPoint*> splitPoints;
+    };
+    // One per thread during a YBWC search
+    mutable std::vector<std::unique_ptr<WorkQueue>> workQueues;
+
+    // State owned by one search thread
+    struct SearchContext {
+        // Index into workQueues for YBWC, helper index for Lazy SMP; 0 is the calling thread
+        int threadIndex = 0;
+        int rootDepth = 0;
+        // Flushed into nodesSearched and the table's totals by flushCounts() when the thread
+        // finishes, to keep the shared counters uncontended
+        uint64_t nodes = 0;
+        TranspositionTable::Stats tableCounts;
+        // Innermost YBWC split point this thread is working under
+        const SplitPoint* splitPoint = nullptr;
+
+        // Moves that caused a cutoff, two per ply counted from the start of the game.
+        // Kept for the whole getBestMove() call so every iteration benefits.
+        std::array<std::array<BoardPosition, 2>, BoardManager::CELL_COUNT + 1> killers;
+        // Butterfly history: cutoffs caused by each move of each color, weighted by depth
+        std::array<std::array<std::array<int, Size>, Size>, 2> history{};
+        BasicVCFSolver<Size> leafVcf{VCF_LEAF_MAX_DEPTH, VCF_LEAF_MAX_NODES};
+        // Quiescence nodes left below the current leaf
+        int quiescenceNodes = 0;
+        // Set while searching the reply to a null move; two passes in a row prove nothing
+        bool afterNullMove = false;
+
+        void clearKillers() {
+            for (auto& slots : killers) {
+                slots = {BoardPosition{-1, -1}, BoardPosition{-1, -1}};
+            }
+        }
+        // Old history still says something about the position, just less
+        void ageHistory() {
+            for (auto& side : history) {
+                for (auto& row : side) {
+                    for (int& entry : row) entry /= 2;
+                }
+            }
+        }
+    };
+    // History entries are halved once one passes this, keeping order keys in range
+    static constexpr int HISTORY_LIMIT = 1 << 20;
+
+    // One context per thread for the Sequential, Lazy SMP and YBWC modes
+    mutable std::vector<std::unique_ptr<SearchContext>> searchContexts;
+
+    // Clears the killers and ages the history before a new getBestMove() call
+    void prepareSearchContexts() const;
+    // The context of thread `index`, reset for a search from the root at rootDepth
+    [[nodiscard]] SearchContext& threadContext(int index, int rootDepth) const;
+    void flushCounts(const SearchContext& context) const;
+    // Credits a move that caused a beta cutoff to the killers and history of the context
+    void recordCutoff(SearchContext& context, const BoardManager& boardManager, BoardPosition position, int depth) const;
+
+    // True once the time budget is spent or requestStop() was called
+    [[nodiscard]] bool searchAborted() const {
+        return searchStop.load(std::memory_order_relaxed);
+    }
+    // Helpers also stop as soon as the main thread is done, and any thread below a YBWC cutoff
+    [[nodiscard]] bool searchAborted(const SearchContext& context) const {
+        return (context.threadIndex > 0 && helpersStop.load(std::memory_order_relaxed)) ||
+               (context.splitPoint && context.splitPoint->cutoffInChain()) ||
+               searchAborted();
+    }
+
     /// @brief Splits a vector into smaller chunks of specified size.
     /// @param content the vector to be split into chunks.
     /// @param chunkSize the desired size of each chunk. 
@@ -89,63 +368,107 @@ private:
                                    BoardPosition position,
                                    char player) const;
 
-    // Get possible candidate moves within a certain radius of existing pieces
-    [[nodiscard]] std::vector<BoardPosition> candidateMoves(const BoardManager& boardManager) const;
+    // Get possible candidate moves within a certain radius of existing pieces.
+    // Threat moves still come first; within the threat and quiet groups, moves follow the
+    // context's killers and history when one is given. threatCount, if given, receives the
+    // number of threat moves at the front.
+    [[nodiscard]] std::vector<BoardPosition> candidateMoves(
+        const BoardManager& boardManager,
+        const SearchContext* context = nullptr,
+        size_t* threatCount = nullptr
+    ) const;
 
     // Heuristic evaluation of the board for a given player. Returns a score relative to the player's perspective.
+    // Reads the pattern totals BoardManager maintains on make/undo, so it costs O(1).
     [[nodiscard]] int evaluate(const BoardManager& boardManager, char player) const;
 
-    [[nodiscard]] inline static bool isInsideBoard(int row, int col) {
-        return row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE;
-    }
-
-    [[nodiscard]] inline static int sequenceScore(int length, int openSides) {
-        if (length >= 5) {
-            return 1000000;
-        }
+    // Negamax principal variation search: the first move gets the full window, the rest a
+    // null window, re-searched only if they fail high. Fail-soft; the score is from the side
+    // to move's perspective. Returns a pair of (score, best move)
+    [[nodiscard]] std::pair<int, BoardPosition> principalVariationSearch(
+        SearchContext& context,
+        BoardManager& boardManager,
+        int depth,
+        int alpha,
+        int beta
+    ) const;
 
-        switch (length) {
-            case 4:
-                if (openSides == 2) return 50000;
-                if (openSides == 1) return 10000;
-                return 300;
-            case 3:
-                if (openSides == 2) return 2000;
-                if (openSides == 1) return 400;
-                return 50;
-            case 2:
-                if (openSides == 2) return 200;
-                if (openSides == 1) return 60;
-                return 10;
-            case 1:
-                if (openSides == 2) return 20;
-                if (openSides == 1) return 5;
-                return 1;
-            default:
-                return 0;
-        }
-    }
+    // Search past the horizon over forcing moves only. The side to move may stand on the
+    // static evaluation unless it must block a four, or answer the three the opponent just
+    // played (threatBefore, the opponent's masks before it, when threes are extended).
+    // Fail-soft, from the side to move's perspective.
+    [[nodiscard]] int quiescenceSearch(
+        SearchContext& context,
+        BoardManager& boardManager,
+        int ply,
+        int alpha,
+        int beta,
+        const ThreatMasks* threatBefore = nullptr
+    ) const;
 
-    [[nodiscard]] std::pair<SequenceSummary, SequenceSummary> 
-    evaluateSequences(const BoardManager& boardManager) const;
+    // Alpha-beta search parallelizing the root level.
+    // firstMove, if a candidate, is searched first. Returns a pair of (score, best move)
+    [[nodiscard]] std::pair<int, BoardPosition> rootSplitSearch(
+        BoardManager& boardManager,
+        int depth,
+        BoardPosition firstMove,
+        int alpha,
+        int beta
+    ) const;
 
-    [[nodiscard]] int centerControlBias(const BoardManager& boardManager, char player) const;
+    // Lazy SMP: helper threads search the same position at depth and depth + 1 while the
+    // calling thread searches depth. Returns the calling thread's (score, best move)
+    [[nodiscard]] std::pair<int, BoardPosition> lazySmpSearch(
+        BoardManager& boardManager,
+        int depth,
+        int alpha,
+        int beta
+    ) const;
 
-    // minimax with alpha-beta pruning. Returns a pair of (score, best move)
-    [[nodiscard]] std::pair<int, BoardPosition>
-    minimaxAlphaBeta(
+    // YBWC: the calling thread searches the tree while pool workers steal split points.
+    // Returns the calling thread's (score, best move)
+    [[nodiscard]] std::pair<int, BoardPosition> youngBrothersWaitSearch(
         BoardManager& boardManager,
         int depth,
-        bool isMaximizing,
         int alpha,
         int beta
     ) const;
 
-    // minimax with alpha-beta pruning and parallelizing the root level.
+    // Opens a split point for moves[1..] after the first move was searched at this node,
+    // works on it alongside any thieves, and folds the outcome back into alpha and best
+    void searchYoungerBrothers(
+        SearchContext& context,
+        BoardManager& boardManager,
+        int depth,
+        const std::vector<BoardPosition>& moves,
+        int& alpha,
+        int beta,
+        int& bestScore,
+        BoardPosition& bestMove
+    ) const;
+
+    // Searches moves of the split point until none are left or it is cut off
+    void workAtSplitPoint(SearchContext& context, SplitPoint& splitPoint, BoardManager& boardManager) const;
+
+    // Joins an open split point of another thread, or returns nullptr
+    [[nodiscard]] SplitPoint* stealSplitPoint(int thief) const;
+
+    // Loop run by each YBWC pool worker until helpersStop is set
+    void youngBrothersWaitWorker(SearchContext& context) const;
+
+    // The root forced-win check: VCF, then VCT or df-pn. Returns {-1, -1} if neither finds one.
+    [[nodiscard]] BoardPosition findForcedWin(BoardManager& boardManager) const;
+
+    // One fixed-depth search from the root in the current SearchMode, within [alpha, beta].
     // Returns a pair of (score, best move)
-    [[nodiscard]] BoardPosition minimaxAlphaBetaRootParallel(
+    [[nodiscard]] std::pair<int, BoardPosition> searchRoot(
         BoardManager& boardManager,
-        int depth
+        int depth,
+        BoardPosition firstMove,
+        int alpha,
+        int beta
     ) const;
 };
 
+// The engine the GUI plays against
+using GomokuAI = BasicGomokuAI<BOARD_SIZE>;
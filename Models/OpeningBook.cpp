@@ -0,0 +1,127 @@
+//
+// Created by Samuel He on 2025/11/23.
+//
+
+#include "OpeningBook.h"
+#include <cstring>
+#include <iostream>
+
+template <int Size>
+bool BasicOpeningBook<Size>::open(const QString& path) {
+    close();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "Cannot open opening book " << path.toStdString() << std::endl;
+        return false;
+    }
+
+    Header header{};
+    const qint64 fileSize = file.size();
+    if (fileSize >= qint64(sizeof(Header))) {
+        mapping = file.map(0, fileSize);
+    }
+    if (mapping) {
+        std::memcpy(&header, mapping, sizeof(Header));
+    }
+
+    const bool valid = mapping &&
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+        header.version == VERSION &&
+        header.boardSize == uint32_t(Size) &&
+        header.slotCount > 0 && (header.slotCount & (header.slotCount - 1)) == 0 &&
+        header.entryCount <= header.slotCount / 2 &&
+        uint64_t(fileSize) == sizeof(Header) + header.slotCount * sizeof(Entry);
+    if (!valid) {
+        std::cerr << "Not a " << Size << "x" << Size << " opening book: " << path.toStdString() << std::endl;
+        close();
+        return false;
+    }
+
+    slots = reinterpret_cast<const Entry*>(mapping + sizeof(Header));
+    slotMask = header.slotCount - 1;
+    entryCount = header.entryCount;
+    return true;
+}
+
+template <int Size>
+void BasicOpeningBook<Size>::close() {
+    if (mapping) {
+        file.unmap(mapping);
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+    mapping = nullptr;
+    slots = nullptr;
+    slotMask = 0;
+    entryCount = 0;
+}
+
+template <int Size>
+BoardPosition BasicOpeningBook<Size>::probe(const BoardManager& boardManager) const {
+    if (!slots) {
+        return {-1, -1};
+    }
+
+    const auto [key, symmetry] = boardManager.canonicalHash();
+    if (key == 0) {
+        return {-1, -1};
+    }
+    // The header's entry count is checked, but a damaged table could still have no empty slot
+    uint64_t index = key & slotMask;
+    for (uint64_t probes = 0; probes <= slotMask; ++probes, index = (index + 1) & slotMask) {
+        const Entry& entry = slots[index];
+        if (entry.key == 0) {
+            return {-1, -1};
+        }
+        if (entry.key == key) {
+            const BoardPosition move = BoardManager::inverseTransform({entry.row, entry.col}, symmetry);
+            // A key collision could name an occupied or off-board cell
+            return boardManager.isValidMove(move) ? move : BoardPosition{-1, -1};
+        }
+    }
+    return {-1, -1};
+}
+
+template <int Size>
+bool BasicOpeningBook<Size>::write(const QString& path, const std::vector<Entry>& entries) {
+    // At most half full, so probe runs stay short and always end at an empty slot
+    uint64_t slotCount = 16;
+    while (slotCount < 2 * entries.size()) {
+        slotCount *= 2;
+    }
+
+    std::vector<Entry> table(slotCount, Entry{});
+    for (const Entry& entry : entries) {
+        uint64_t index = entry.key & (slotCount - 1);
+        while (table[index].key != 0) {
+            index = (index + 1) & (slotCount - 1);
+        }
+        table[index] = entry;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.boardSize = Size;
+    header.slotCount = slotCount;
+    header.entryCount = entries.size();
+
+    QFile output(path);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << "Cannot write opening book " << path.toStdString() << std::endl;
+        return false;
+    }
+    const qint64 tableBytes = qint64(slotCount * sizeof(Entry));
+    if (output.write(reinterpret_cast<const char*>(&header), sizeof(Header)) != qint64(sizeof(Header)) ||
+        output.write(reinterpret_cast<const char*>(table.data()), tableBytes) != tableBytes) {
+        std::cerr << "Cannot write opening book " << path.toStdString() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template class BasicOpeningBook<15>;
+template class BasicOpeningBook<19>;
+template class BasicOpeningBook<20>;
@@ -0,0 +1,75 @@
+//
+// Created by Samuel He on 2025/11/23.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include "Constants.h"
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+// Read-only opening book, memory-mapped rather than loaded: an open book costs no heap and a
+// probe touches a handful of bytes of the file.
+//
+// File layout (little-endian):
+//   Header   magic "GMKBOOK1", uint32 version, uint32 board size, uint64 slot count, uint64 entry count
+//   Slots    slot count (a power of two) x Entry, open addressing with linear probing, key 0 = empty
+//
+// Keys are BoardManager::canonicalHash() values and moves are stored in the canonical
+// orientation, so one entry serves all 8 rotations and mirrors of a position.
+template <int Size>
+class BasicOpeningBook {
+public:
+    using BoardManager = BasicBoardManager<Size>;
+
+    struct Entry {
+        uint64_t key;
+        uint8_t row;
+        uint8_t col;
+        uint16_t reserved;
+        uint32_t count; // Games the move was played in
+    };
+    static_assert(sizeof(Entry) == 16, "book entries are written as raw 16-byte records");
+
+    BasicOpeningBook() = default;
+    ~BasicOpeningBook() { close(); }
+    BasicOpeningBook(const BasicOpeningBook&) = delete;
+    BasicOpeningBook& operator=(const BasicOpeningBook&) = delete;
+
+    // Maps the book, replacing any open one. Prints the reason and returns false if the file
+    // can't be mapped or isn't a book for this board size.
+    bool open(const QString& path);
+    void close();
+    [[nodiscard]] bool isOpen() const { return slots != nullptr; }
+    [[nodiscard]] uint64_t size() const { return entryCount; }
+
+    // The book move for the side to move, or {-1, -1} if the position isn't in the book
+    [[nodiscard]] BoardPosition probe(const BoardManager& boardManager) const;
+
+    // Writes entries (canonical keys, canonical moves, unique keys, no key 0) as a book file
+    static bool write(const QString& path, const std::vector<Entry>& entries);
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t boardSize;
+        uint64_t slotCount;
+        uint64_t entryCount;
+    };
+    static_assert(sizeof(Header) == 32, "the book header is written as a raw 32-byte record");
+
+    static constexpr char MAGIC[8] = {'G', 'M', 'K', 'B', 'O', 'O', 'K', '1'};
+    static constexpr uint32_t VERSION = 1;
+
+    QFile file;
+    uchar* mapping = nullptr;
+    const Entry* slots = nullptr;
+    uint64_t slotMask = 0;
+    uint64_t entryCount = 0;
+};
+
+using OpeningBook = BasicOpeningBook<BOARD_SIZE>;
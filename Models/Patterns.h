@@ -0,0 +1,244 @@
+//
+// Created by Samuel He on 2025/11/16.
+//
+
+#pragma once
+
+#include "BitOps.h"
+#include <array>
+#include <cstdint>
+
+// Pattern counts and score for one player's stones
+struct SequenceSummary {
+    int score = 0;
+    int openThrees = 0;
+    int semiOpenThrees = 0;
+    int openFours = 0;
+    int semiOpenFours = 0;
+
+    SequenceSummary& operator+=(const SequenceSummary& other) {
+        score += other.score;
+        openThrees += other.openThrees;
+        semiOpenThrees += other.semiOpenThrees;
+        openFours += other.openFours;
+        semiOpenFours += other.semiOpenFours;
+        return *this;
+    }
+
+    SequenceSummary& operator-=(const SequenceSummary& other) {
+        score -= other.score;
+        openThrees -= other.openThrees;
+        semiOpenThrees -= other.semiOpenThrees;
+        openFours -= other.openFours;
+        semiOpenFours -= other.semiOpenFours;
+        return *this;
+    }
+};
+
+// Score and threat counts of one pattern, packed for the lookup table
+struct PatternEntry {
+    int score = 0;
+    uint8_t openThrees = 0;
+    uint8_t semiOpenThrees = 0;
+    uint8_t openFours = 0;
+    uint8_t semiOpenFours = 0;
+};
+
+inline SequenceSummary& operator+=(SequenceSummary& summary, const PatternEntry& entry) {
+    summary.score += entry.score;
+    summary.openThrees += entry.openThrees;
+    summary.semiOpenThrees += entry.semiOpenThrees;
+    summary.openFours += entry.openFours;
+    summary.semiOpenFours += entry.semiOpenFours;
+    return summary;
+}
+
+[[nodiscard]] constexpr int sequenceScore(const int length, const int openSides) {
+    if (length >= 5) {
+        return 1000000;
+    }
+
+    switch (length) {
+        case 4:
+            if (openSides == 2) return 50000;
+            if (openSides == 1) return 10000;
+            return 300;
+        case 3:
+            if (openSides == 2) return 2000;
+            if (openSides == 1) return 400;
+            return 50;
+        case 2:
+            if (openSides == 2) return 200;
+            if (openSides == 1) return 60;
+            return 10;
+        case 1:
+            if (openSides == 2) return 20;
+            if (openSides == 1) return 5;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Score and threat counts of one contiguous sequence
+[[nodiscard]] constexpr PatternEntry sequencePattern(const int length, const int openSides) {
+    PatternEntry entry;
+    entry.score = sequenceScore(length, openSides);
+
+    if (length >= 5) {
+        // Already won whatever its ends, which a run longer than the window can't see anyway
+        entry.openFours = 1;
+        return entry;
+    }
+
+    if (length == 4) {
+        if (openSides == 2) {
+            entry.openFours = 1;
+        } else if (openSides == 1) {
+            entry.semiOpenFours = 1;
+        }
+    } else if (length == 3) {
+        if (openSides == 2) {
+            entry.openThrees = 1;
+        } else if (openSides == 1) {
+            entry.semiOpenThrees = 1;
+        }
+    }
+
+    return entry;
+}
+
+// A pattern window covers the cell before a sequence and the seven cells from its first stone,
+// one base-3 digit per cell, lowest digit first
+constexpr int PATTERN_WINDOW = 8;
+constexpr int PATTERN_COUNT = 6561; // 3^PATTERN_WINDOW
+
+enum PatternCell {
+    PatternBlocked = 0, // Opponent stone or off the board
+    PatternOwn = 1,
+    PatternEmpty = 2
+};
+
+// Orders entries by score, then by the threat counts, so the strongest shape of a segment
+// doesn't depend on which end of the line it is read from
+[[nodiscard]] constexpr bool outranks(const PatternEntry& entry, const PatternEntry& other) {
+    if (entry.score != other.score) return entry.score > other.score;
+    if (entry.openFours != other.openFours) return entry.openFours > other.openFours;
+    if (entry.semiOpenFours != other.semiOpenFours) return entry.semiOpenFours > other.semiOpenFours;
+    if (entry.openThrees != other.openThrees) return entry.openThrees > other.openThrees;
+    return entry.semiOpenThrees > other.semiOpenThrees;
+}
+
+// Scores the sequence starting at window cell 1. Beyond contiguous runs this recognises
+// broken shapes with a single gap: X_XXX, XX_XX and XXX_X are fours, X_XX and XX_X threes.
+[[nodiscard]] constexpr PatternEntry classifyPatternWindow(const int (&cells)[PATTERN_WINDOW]) {
+    if (cells[1] != PatternOwn || cells[0] == PatternOwn) {
+        return {}; // Not the start of a sequence
+    }
+
+    int length = 1;
+    while (1 + length < PATTERN_WINDOW && cells[1 + length] == PatternOwn) {
+        ++length;
+    }
+    const int openStart = cells[0] == PatternEmpty ? 1 : 0;
+    const int openEnd = 1 + length < PATTERN_WINDOW && cells[1 + length] == PatternEmpty ? 1 : 0;
+    PatternEntry entry = sequencePattern(length, openStart + openEnd);
+
+    // A single gap followed by more stones: filling the gap joins both parts
+    if (length <= 3 && openEnd && cells[2 + length] == PatternOwn) {
+        int tail = 1;
+        while (2 + length + tail < PATTERN_WINDOW && cells[2 + length + tail] == PatternOwn) {
+            ++tail;
+        }
+
+        PatternEntry broken;
+        if (length + tail >= 4) {
+            // Only the gap completes five, like a four with one open side
+            broken = sequencePattern(4, 1);
+        } else {
+            const int farEnd = 2 + length + tail;
+            const int openFar = farEnd < PATTERN_WINDOW && cells[farEnd] == PatternEmpty ? 1 : 0;
+            broken = sequencePattern(length + tail, openStart + openFar);
+        }
+        if (outranks(broken, entry)) {
+            entry = broken;
+        }
+    }
+
+    return entry;
+}
+
+[[nodiscard]] constexpr std::array<PatternEntry, PATTERN_COUNT> buildPatternTable() {
+    std::array<PatternEntry, PATTERN_COUNT> table{};
+    for (int code = 0; code < PATTERN_COUNT; ++code) {
+        int cells[PATTERN_WINDOW] = {};
+        int rest = code;
+        for (int& cell : cells) {
+            cell = rest % 3;
+            rest /= 3;
+        }
+        table[code] = classifyPatternWindow(cells);
+    }
+    return table;
+}
+
+// Sum of 3^i over the set bits of an 8-bit window mask
+[[nodiscard]] constexpr std::array<uint16_t, 256> buildBase3Digits() {
+    std::array<uint16_t, 256> digits{};
+    for (int mask = 0; mask < 256; ++mask) {
+        int value = 0;
+        int power = 1;
+        for (int bit = 0; bit < PATTERN_WINDOW; ++bit) {
+            if (mask >> bit & 1) {
+                value += power;
+            }
+            power *= 3;
+        }
+        digits[mask] = static_cast<uint16_t>(value);
+    }
+    return digits;
+}
+
+inline constexpr std::array<PatternEntry, PATTERN_COUNT> patternTable = buildPatternTable();
+inline constexpr std::array<uint16_t, 256> base3Digits = buildBase3Digits();
+
+// Table lookup for the sequence whose first stone is at bit `start` of the line
+[[nodiscard]] inline const PatternEntry& patternAt(const LineMask stones, const LineMask empty, const int start) {
+    const LineMask own = ((stones << 1) >> start) & 0xFF;
+    const LineMask open = ((empty << 1) >> start) & 0xFF;
+    return patternTable[base3Digits[own] + 2 * base3Digits[open]];
+}
+
+// Runs one empty cell apart from each other make up a segment, e.g. XX_X or X_X_XX, scored once as its
+// strongest contiguous or broken shape. Scoring each run on its own would count the stones past
+// a gap twice, and only when the line is read from the side where the gap comes first.
+// Returns the entry for the segment whose first stone is at bit `start` of the line.
+[[nodiscard]] inline PatternEntry segmentPattern(const LineMask stones, const LineMask empty, const int start) {
+    const LineMask runStarts = stones & ~(stones << 1);
+    const LineMask continued = runStarts & (empty << 1) & (stones << 2);
+
+    PatternEntry best = patternAt(stones, empty, start);
+    LineMask later = runStarts & ~((LineMask{2} << start) - 1);
+    while (later && (continued >> lowestBit(later) & 1)) {
+        const PatternEntry& entry = patternAt(stones, empty, lowestBit(later));
+        if (outranks(entry, best)) {
+            best = entry;
+        }
+        later &= later - 1;
+    }
+    return best;
+}
+
+// Sums every segment of `stones` along one line, with `empty` marking the open cells
+[[nodiscard]] inline SequenceSummary scoreLine(const LineMask stones, const LineMask empty) {
+    SequenceSummary summary;
+
+    const LineMask runStarts = stones & ~(stones << 1);
+    LineMask starts = runStarts & ~((empty << 1) & (stones << 2));
+    while (starts) {
+        summary += segmentPattern(stones, empty, lowestBit(starts));
+        starts &= starts - 1;
+    }
+
+    return summary;
+}
@@ -0,0 +1,240 @@
+//
+// Created by Samuel He on 2025/11/22.
+//
+
+#include "ProofNumberSolver.h"
+#include "VCTSolver.h"
+#include <algorithm>
+
+template <int Size>
+BasicProofNumberSolver<Size>::BasicProofNumberSolver(const size_t tableSizeMB) {
+    resize(tableSizeMB);
+}
+
+template <int Size>
+void BasicProofNumberSolver<Size>::resize(const size_t sizeMB) {
+    // Largest power of two number of entries that fits in the budget
+    const size_t budget = std::max<size_t>(sizeMB, 1) * 1024 * 1024 / sizeof(Entry);
+    size_t count = 1;
+    while (count * 2 <= budget) {
+        count *= 2;
+    }
+
+    table.assign(count, Entry{});
+    indexMask = count - 1;
+    generation = 0;
+}
+
+template <int Size>
+typename BasicProofNumberSolver<Size>::Entry BasicProofNumberSolver<Size>::lookup(
+    const uint64_t key,
+    const int ply
+) const {
+    const uint64_t slotKey = plyKey(key, ply);
+    const Entry& entry = table[slotKey & indexMask];
+    return entry.key == tag(slotKey) ? Entry{key, entry.proof, entry.disproof} : Entry{key, 1, 1};
+}
+
+template <int Size>
+void BasicProofNumberSolver<Size>::store(const uint64_t key, const int ply, const Number proof, const Number disproof) {
+    const uint64_t slotKey = plyKey(key, ply);
+    table[slotKey & indexMask] = {tag(slotKey), proof, disproof};
+}
+
+template <int Size>
+typename BasicProofNumberSolver<Size>::Result BasicProofNumberSolver<Size>::prove(
+    BoardManager& boardManager,
+    const char attacker,
+    BoardPosition* bestMove
+) {
+    nodes = 0;
+    aborted = false;
+    if (boardManager.sideToMove() != attacker || boardManager.checkWinner() != EMPTY) {
+        return Result::Disproven;
+    }
+
+    // A new generation drops the previous call's entries without touching the table. Only
+    // once the tags run out is it cleared, after as many calls as it has entries.
+    if (++generation > indexMask) {
+        std::fill(table.begin(), table.end(), Entry{});
+        generation = 1;
+    }
+    this->attacker = attacker;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeLimitMs);
+
+    search(boardManager, 0, nullptr, INFINITE, INFINITE);
+
+    const Entry root = lookup(boardManager.hash(), 0);
+    if (root.proof != 0) {
+        return root.disproof == 0 ? Result::Disproven : Result::Unknown;
+    }
+
+    if (bestMove) {
+        ThreatMasks attack;
+        BoardPosition moves[BoardManager::CELL_COUNT];
+        Number proof, disproof;
+        const int count = generateMoves(boardManager, 0, nullptr, attack, moves, proof, disproof);
+        if (count < 0) {
+            // Won on the spot
+            collectThreatCells<Size>(attack.win, bestMove, 1);
+        }
+        for (int i = 0; i < count; ++i) {
+            if (lookup(boardManager.hashAfter(moves[i]), 1).proof == 0) {
+                *bestMove = moves[i];
+                break;
+            }
+        }
+    }
+    return Result::Proven;
+}
+
+template <int Size>
+int BasicProofNumberSolver<Size>::generateMoves(
+    const BoardManager& boardManager,
+    const int ply,
+    const ThreatMasks* attackBefore,
+    ThreatMasks& attack,
+    BoardPosition* moves,
+    Number& proof,
+    Number& disproof
+) const {
+    const char defender = attacker == BLACK ? WHITE : BLACK;
+    const bool attackerToMove = boardManager.sideToMove() == attacker;
+
+    // Fours only matter on the attacker's move
+    attack = computeThreatMasks(boardManager, attacker, attackerToMove);
+    const ThreatMasks defence = computeThreatMasks(boardManager, defender);
+    const auto& moverWins = attackerToMove ? attack.win : defence.win;
+    const auto& waitingWins = attackerToMove ? defence.win : attack.win;
+
+    // A five for the side to move wins; two for the other side can't both be blocked
+    BoardPosition fives[2];
+    const bool moverFive = collectThreatCells<Size>(moverWins, fives, 1) > 0;
+    const int waitingFives = moverFive ? 0 : collectThreatCells<Size>(waitingWins, fives, 2);
+    if (moverFive || waitingFives == 2) {
+        const bool attackerWins = moverFive == attackerToMove;
+        proof = attackerWins ? 0 : INFINITE;
+        disproof = attackerWins ? INFINITE : 0;
+        return -1;
+    }
+    if (ply >= _maxPly) {
+        proof = INFINITE;
+        disproof = 0;
+        return -1;
+    }
+
+    int count = 0;
+    if (waitingFives == 1) {
+        // The only move that doesn't lose; for the attacker it must also keep the initiative
+        if (!attackerToMove || attack.makesFour(fives[0]) || attack.threatens(fives[0])) {
+            moves[count++] = fives[0];
+        }
+    } else if (attackerToMove) {
+        uint32_t candidates[THREAT_KERNEL_MAX_SIZE] = {};
+        for (int row = 0; row < Size; ++row) {
+            candidates[row] = attack.four[row] | attack.threat[row];
+        }
+        count = collectThreatCells<Size>(candidates, moves, BoardManager::CELL_COUNT);
+    } else if (attackBefore) {
+        count = BasicVCTSolver<Size>::threatReplies(boardManager, attacker, *attackBefore, moves);
+    }
+
+    if (count == 0) {
+        // An attacker out of threats, or a three the defender may ignore
+        proof = INFINITE;
+        disproof = 0;
+        return -1;
+    }
+    proof = attackerToMove ? 1 : static_cast<Number>(count);
+    disproof = attackerToMove ? static_cast<Number>(count) : 1;
+    return count;
+}
+
+template <int Size>
+void BasicProofNumberSolver<Size>::search(
+    BoardManager& boardManager,
+    const int ply,
+    const ThreatMasks* attackBefore,
+    const Number proofThreshold,
+    const Number disproofThreshold
+) {
+    const uint64_t key = boardManager.hash();
+    const Entry cached = lookup(key, ply);
+    if (cached.proof >= proofThreshold || cached.disproof >= disproofThreshold) {
+        return;
+    }
+
+    ++nodes;
+    if (nodes >= _maxNodes || (stopToken && stopToken->load(std::memory_order_relaxed)) ||
+        (_timeLimitMs > 0 && nodes % TIME_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline)) {
+        aborted = true;
+    }
+
+    ThreatMasks attack;
+    BoardPosition moves[BoardManager::CELL_COUNT];
+    Number proof, disproof;
+    const int count = generateMoves(boardManager, ply, attackBefore, attack, moves, proof, disproof);
+    if (count < 0) {
+        store(key, ply, proof, disproof);
+        return;
+    }
+
+    // At an attacker node one proven child proves it and every child must be disproven;
+    // a defender node is the mirror image
+    const bool orNode = boardManager.sideToMove() == attacker;
+    uint64_t childKeys[BoardManager::CELL_COUNT];
+    for (int i = 0; i < count; ++i) {
+        childKeys[i] = boardManager.hashAfter(moves[i]);
+    }
+
+    while (!aborted) {
+        // "Minimised" is the number the node takes the minimum of, "summed" the other one
+        Number minimised = INFINITE;
+        Number second = INFINITE;
+        uint64_t summed = 0;
+        int best = 0;
+        for (int i = 0; i < count; ++i) {
+            const Entry child = lookup(childKeys[i], ply + 1);
+            const Number childMin = orNode ? child.proof : child.disproof;
+            const Number childSum = orNode ? child.disproof : child.proof;
+            if (childMin < minimised) {
+                second = minimised;
+                minimised = childMin;
+                best = i;
+            } else if (childMin < second) {
+                second = childMin;
+            }
+            summed = std::min<uint64_t>(summed + childSum, INFINITE);
+        }
+        proof = orNode ? minimised : static_cast<Number>(summed);
+        disproof = orNode ? static_cast<Number>(summed) : minimised;
+        if (proof >= proofThreshold || disproof >= disproofThreshold) {
+            break;
+        }
+        store(key, ply, proof, disproof);
+
+        // Stay in the best child until it falls behind the second best or exhausts the
+        // node's own threshold on the summed number
+        const Entry child = lookup(childKeys[best], ply + 1);
+        const Number minThreshold = orNode ? proofThreshold : disproofThreshold;
+        const Number sumThreshold = orNode ? disproofThreshold : proofThreshold;
+        const Number childSum = orNode ? child.disproof : child.proof;
+        const Number childMinThreshold = std::min<Number>(minThreshold, second == INFINITE ? INFINITE : second + 1);
+        const Number childSumThreshold = static_cast<Number>(
+            std::min<uint64_t>(uint64_t(sumThreshold) - summed + childSum, INFINITE)
+        );
+
+        boardManager.makeMove(moves[best]);
+        search(
+            boardManager, ply + 1, orNode ? &attack : nullptr,
+            orNode ? childMinThreshold : childSumThreshold,
+            orNode ? childSumThreshold : childMinThreshold
+        );
+        boardManager.undoMove();
+    }
+    store(key, ply, proof, disproof);
+}
+
+template class BasicProofNumberSolver<15>;
+template class BasicProofNumberSolver<19>;
+template class BasicProofNumberSolver<20>;
@@ -0,0 +1,106 @@
+//
+// Created by Samuel He on 2025/11/22.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include "Constants.h"
+#include "ThreatKernels.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Depth-first proof-number search (df-pn) over the same threat space as the VCT solver: the
+// attacker plays fours and threes, the defender the forced block or the replies that stop the
+// three. Unlike the bounded VCT it keeps going on the most promising line until the position
+// is solved or the budget runs out, so it settles positions the other solvers give up on.
+template <int Size>
+class BasicProofNumberSolver {
+public:
+    using BoardManager = BasicBoardManager<Size>;
+
+    enum class Result {
+        Proven,    // The attacker wins against every defence
+        Disproven, // No win within the threat space and the ply limit
+        Unknown    // Budget ran out first
+    };
+
+    explicit BasicProofNumberSolver(size_t tableSizeMB = PN_TABLE_SIZE_MB);
+
+    // Solves the position for attacker, who must be the side to move. When proven and
+    // bestMove is given, it receives a winning move. The board is back in its original state
+    // on return.
+    Result prove(BoardManager& boardManager, char attacker, BoardPosition* bestMove = nullptr);
+
+    // Both limits apply to each prove() call; a time limit of 0 means none
+    void setMaxNodes(uint64_t nodes) { _maxNodes = nodes; }
+    [[nodiscard]] uint64_t getMaxNodes() const { return _maxNodes; }
+    void setTimeLimit(int milliseconds) { _timeLimitMs = milliseconds; }
+    [[nodiscard]] int getTimeLimit() const { return _timeLimitMs; }
+    void setMaxPly(int ply) { _maxPly = ply; }
+    [[nodiscard]] int getMaxPly() const { return _maxPly; }
+    // prove() also gives up once *token is set, e.g. by another thread; nullptr for none
+    void setStopToken(const std::atomic<bool>* token) { stopToken = token; }
+
+    // Reallocates the table, dropping its contents
+    void resize(size_t sizeMB);
+
+    // Nodes expanded by the last prove() call
+    [[nodiscard]] uint64_t lastNodes() const { return nodes; }
+
+private:
+    using Number = uint32_t;
+    static constexpr Number INFINITE = 1u << 30;
+
+    // Proof and disproof numbers, both from the attacker's point of view
+    struct Entry {
+        uint64_t key = 0;
+        Number proof = 1;
+        Number disproof = 1;
+    };
+
+    std::vector<Entry> table;
+    size_t indexMask = 0;
+    // Results depend on the attacker, so each prove() call only reads its own entries. A slot's
+    // key word holds the key's bits above the index and,
+    // in the index bits the slot position already implies, the generation of the call that
+    // wrote it. Starts at 1, so a never written slot matches nothing.
+    uint64_t generation = 0;
+
+    uint64_t _maxNodes = PN_MAX_NODES;
+    int _timeLimitMs = 0;
+    int _maxPly = PN_MAX_PLY;
+    const std::atomic<bool>* stopToken = nullptr;
+
+    char attacker = BLACK;
+    uint64_t nodes = 0;
+    bool aborted = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    static constexpr uint64_t TIME_CHECK_INTERVAL = 1024;
+
+    [[nodiscard]] uint64_t tag(const uint64_t key) const { return (key & ~uint64_t(indexMask)) | generation; }
+    // A position cut off at the ply limit reads as disproven, which says nothing about the same
+    // position with more plies left, so the ply is part of the key
+    static uint64_t plyKey(const uint64_t key, const int ply) { return key ^ uint64_t(ply) * 0x9E3779B97F4A7C15ull; }
+    // Unseen positions, including ones stored by an earlier prove() call, read as (1, 1)
+    [[nodiscard]] Entry lookup(uint64_t key, int ply) const;
+    // Always replaces: a parent rereads its children right after searching them, so a child
+    // that couldn't be stored would be picked again forever
+    void store(uint64_t key, int ply, Number proof, Number disproof);
+
+    // Fills moves with the children of the current position and returns their count, or -1
+    // after setting proof/disproof if the position is already decided. attackBefore is the
+    // attacker's masks at the parent, needed to answer a three.
+    int generateMoves(const BoardManager& boardManager, int ply, const ThreatMasks* attackBefore,
+                      ThreatMasks& attack, BoardPosition* moves, Number& proof, Number& disproof) const;
+
+    // Multiple iterative deepening: expands the position until its numbers reach the thresholds
+    void search(BoardManager& boardManager, int ply, const ThreatMasks* attackBefore,
+                Number proofThreshold, Number disproofThreshold);
+};
+
+using ProofNumberSolver = BasicProofNumberSolver<BOARD_SIZE>;
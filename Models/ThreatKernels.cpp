@@ -0,0 +1,110 @@
+//
+// Created by Samuel He on 2025/11/19.
+//
+
+#include "ThreatKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GOMOKU_X86_KERNELS 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace {
+#include "ThreatKernelsImpl.h"
+
+    struct ScalarVector {
+        using Type = uint32_t;
+        static constexpr int LANES = 1;
+
+        static Type zero() { return 0; }
+        static Type load(const uint32_t* source) { return *source; }
+        static void store(uint32_t* target, const Type value) { *target = value; }
+        static Type andOp(const Type a, const Type b) { return a & b; }
+        static Type orOp(const Type a, const Type b) { return a | b; }
+        static Type andNot(const Type a, const Type b) { return ~a & b; }
+        static Type shift(const Type value, const int s) { return s >= 0 ? value >> s : value << -s; }
+    };
+
+    void threatMasksScalar(const ThreatKernelInput& input, ThreatMasks& output, const bool includeFours) {
+        if (includeFours) {
+            threatMasksKernel<ScalarVector, true>(input, output);
+        } else {
+            threatMasksKernel<ScalarVector, false>(input, output);
+        }
+    }
+}
+
+#if GOMOKU_X86_KERNELS
+// Defined in ThreatKernelsSse42.cpp and ThreatKernelsAvx2.cpp, which are built with those ISAs enabled
+void threatMasksSse42(const ThreatKernelInput& input, ThreatMasks& output, bool includeFours);
+void threatMasksAvx2(const ThreatKernelInput& input, ThreatMasks& output, bool includeFours);
+#endif
+
+namespace {
+    bool cpuSupports(const ThreatKernel kernel) {
+        if (kernel == ThreatKernel::Scalar) return true;
+#if GOMOKU_X86_KERNELS
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        if (kernel == ThreatKernel::Sse42) {
+            return (info[2] >> 20) & 1;
+        }
+        // AVX2 also needs the OS to save the YMM registers
+        const bool osSavesYmm = ((info[2] >> 27) & 1) && ((info[2] >> 28) & 1) && (_xgetbv(0) & 6) == 6;
+        if (!osSavesYmm || maxLeaf < 7) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] >> 5) & 1;
+#else
+        __builtin_cpu_init();
+        if (kernel == ThreatKernel::Sse42) {
+            return __builtin_cpu_supports("sse4.2");
+        }
+        return __builtin_cpu_supports("avx2");
+#endif
+#else
+        return false;
+#endif
+    }
+
+    using KernelFunction = void (*)(const ThreatKernelInput&, ThreatMasks&, bool);
+
+    KernelFunction kernelFunction(const ThreatKernel kernel) {
+        switch (kernel) {
+#if GOMOKU_X86_KERNELS
+            case ThreatKernel::Avx2: return threatMasksAvx2;
+            case ThreatKernel::Sse42: return threatMasksSse42;
+#endif
+            default: return threatMasksScalar;
+        }
+    }
+
+    ThreatKernel bestKernel() {
+        if (cpuSupports(ThreatKernel::Avx2)) return ThreatKernel::Avx2;
+        if (cpuSupports(ThreatKernel::Sse42)) return ThreatKernel::Sse42;
+        return ThreatKernel::Scalar;
+    }
+
+    ThreatKernel selectedKernel = bestKernel();
+    KernelFunction selectedFunction = kernelFunction(selectedKernel);
+}
+
+ThreatKernel activeThreatKernel() {
+    return selectedKernel;
+}
+
+bool setThreatKernel(const ThreatKernel kernel) {
+    if (!cpuSupports(kernel)) return false;
+    selectedKernel = kernel;
+    selectedFunction = kernelFunction(kernel);
+    return true;
+}
+
+void computeThreatMasks(const ThreatKernelInput& input, ThreatMasks& output, const bool includeFours) {
+    selectedFunction(input, output, includeFours);
+}
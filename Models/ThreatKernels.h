@@ -0,0 +1,97 @@
+//
+// Created by Samuel He on 2025/11/19.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include <cstdint>
+
+// Whole-board win and threat detection, evaluated for every cell at once with bitwise
+// operations over the row masks. The kernel is built for AVX2, SSE4.2 and plain scalar
+// code; the fastest one the CPU supports is picked at runtime.
+
+constexpr int THREAT_KERNEL_MAX_SIZE = 24;
+// Empty rows around the board so neighbours up to four rows away can be read unchecked
+constexpr int THREAT_KERNEL_PADDING = 8;
+constexpr int THREAT_KERNEL_ROWS = THREAT_KERNEL_MAX_SIZE + 2 * THREAT_KERNEL_PADDING;
+
+// One player's stones and the empty cells, one row mask per board row starting at THREAT_KERNEL_PADDING
+struct alignas(32) ThreatKernelInput {
+    uint32_t own[THREAT_KERNEL_ROWS] = {};
+    uint32_t empty[THREAT_KERNEL_ROWS] = {};
+};
+
+// Per-row results, indexed by board row
+struct alignas(32) ThreatMasks {
+    // Empty cells where the player would complete five or more (GomokuAI::wouldWin)
+    uint32_t win[THREAT_KERNEL_MAX_SIZE] = {};
+    // Empty cells where the player would make a three or four with an open end (GomokuAI::posesThreat)
+    uint32_t threat[THREAT_KERNEL_MAX_SIZE] = {};
+    // Empty cells where the player would make a four: a five-cell window left one move short.
+    // Only filled in when requested.
+    uint32_t four[THREAT_KERNEL_MAX_SIZE] = {};
+
+    [[nodiscard]] bool wins(const BoardPosition position) const { return win[position.row] >> position.col & 1; }
+    [[nodiscard]] bool threatens(const BoardPosition position) const { return threat[position.row] >> position.col & 1; }
+    [[nodiscard]] bool makesFour(const BoardPosition position) const { return four[position.row] >> position.col & 1; }
+};
+
+enum class ThreatKernel {
+    Scalar,
+    Sse42,
+    Avx2
+};
+
+// The kernel used by computeThreatMasks()
+[[nodiscard]] ThreatKernel activeThreatKernel();
+// Overrides the runtime choice, e.g. to benchmark the fallbacks. Returns false if the CPU lacks it.
+bool setThreatKernel(ThreatKernel kernel);
+
+void computeThreatMasks(const ThreatKernelInput& input, ThreatMasks& output, bool includeFours = false);
+
+// Kernel input for the player's stones on a board
+template <int Size>
+[[nodiscard]] ThreatKernelInput threatKernelInput(const BasicBoardManager<Size>& boardManager, const char player) {
+    static_assert(Size <= THREAT_KERNEL_MAX_SIZE, "board does not fit the threat kernel");
+
+    ThreatKernelInput input;
+    for (int row = 0; row < Size; ++row) {
+        input.own[THREAT_KERNEL_PADDING + row] = boardManager.rowStones(player, row);
+        input.empty[THREAT_KERNEL_PADDING + row] = boardManager.rowEmpty(row);
+    }
+    return input;
+}
+
+template <int Size>
+[[nodiscard]] ThreatMasks computeThreatMasks(
+    const BasicBoardManager<Size>& boardManager,
+    const char player,
+    const bool includeFours = false
+) {
+    ThreatMasks masks;
+    computeThreatMasks(threatKernelInput(boardManager, player), masks, includeFours);
+    return masks;
+}
+
+// Calls visit(position) for each set cell of per-row masks, stopping when it returns true
+template <int Size, typename Visitor>
+bool anyThreatCell(const uint32_t (&masks)[THREAT_KERNEL_MAX_SIZE], Visitor&& visit) {
+    for (int row = 0; row < Size; ++row) {
+        for (uint32_t bits = masks[row]; bits; bits &= bits - 1) {
+            if (visit(BoardPosition{row, lowestBit(bits)})) return true;
+        }
+    }
+    return false;
+}
+
+// The set cells of per-row masks, stopping after `limit`
+template <int Size>
+int collectThreatCells(const uint32_t (&masks)[THREAT_KERNEL_MAX_SIZE], BoardPosition* cells, const int limit) {
+    int count = 0;
+    anyThreatCell<Size>(masks, [&](const BoardPosition position) {
+        cells[count++] = position;
+        return count == limit;
+    });
+    return count;
+}
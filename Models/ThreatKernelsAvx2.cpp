@@ -0,0 +1,38 @@
+//
+// Created by Samuel He on 2025/11/19.
+//
+
+// Built with AVX2 enabled; only called after a runtime CPU check.
+
+#include "ThreatKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace {
+#include "ThreatKernelsImpl.h"
+
+    struct Avx2Vector {
+        using Type = __m256i;
+        static constexpr int LANES = 8;
+
+        static Type zero() { return _mm256_setzero_si256(); }
+        static Type load(const uint32_t* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+        static void store(uint32_t* target, const Type value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), value); }
+        static Type andOp(const Type a, const Type b) { return _mm256_and_si256(a, b); }
+        static Type orOp(const Type a, const Type b) { return _mm256_or_si256(a, b); }
+        static Type andNot(const Type a, const Type b) { return _mm256_andnot_si256(a, b); }
+        static Type shift(const Type value, const int s) {
+            return s >= 0 ? _mm256_srl_epi32(value, _mm_cvtsi32_si128(s)) : _mm256_sll_epi32(value, _mm_cvtsi32_si128(-s));
+        }
+    };
+}
+
+void threatMasksAvx2(const ThreatKernelInput& input, ThreatMasks& output, const bool includeFours) {
+    if (includeFours) {
+        threatMasksKernel<Avx2Vector, true>(input, output);
+    } else {
+        threatMasksKernel<Avx2Vector, false>(input, output);
+    }
+}
+#endif
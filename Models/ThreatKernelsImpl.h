@@ -0,0 +1,108 @@
+//
+// Created by Samuel He on 2025/11/19.
+//
+
+#pragma once
+
+#include "ThreatKernels.h"
+
+// Shared body of the threat kernels. Each ISA-specific translation unit includes this inside
+// an anonymous namespace with its own vector type, so the copies built with wider instruction
+// sets never leak into the others at link time.
+//
+// The four masks cost about three times the rest, so they are only computed on request.
+//
+// A vector type V provides:
+//   Type, LANES, zero(), load(const uint32_t*), store(uint32_t*, Type),
+//   andOp(a, b), orOp(a, b), andNot(a, b) = ~a & b, shift(v, s) = bit c takes bit c + s
+
+template <typename V, bool IncludeFours>
+inline void threatMasksKernel(const ThreatKernelInput& input, ThreatMasks& output) {
+    using T = typename V::Type;
+
+    // {row step, column step} for horizontal, vertical, diagonal and anti-diagonal lines
+    constexpr int steps[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+    for (int block = 0; block < THREAT_KERNEL_MAX_SIZE; block += V::LANES) {
+        const int row = THREAT_KERNEL_PADDING + block;
+        T win = V::zero();
+        T threat = V::zero();
+        T four = V::zero();
+
+        for (const auto& step : steps) {
+            const int dr = step[0];
+            const int dc = step[1];
+
+            // Own stones (P forward, N backward) and empty cells (EP, EN) k cells away
+            T P[5], N[5], EP[5], EN[5];
+            for (int k = 1; k <= 4; ++k) {
+                P[k] = V::shift(V::load(input.own + row + k * dr), k * dc);
+                N[k] = V::shift(V::load(input.own + row - k * dr), -k * dc);
+                EP[k] = V::shift(V::load(input.empty + row + k * dr), k * dc);
+                EN[k] = V::shift(V::load(input.empty + row - k * dr), -k * dc);
+            }
+
+            // Five-cell windows through the cell with the other four cells owned
+            const T P12 = V::andOp(P[1], P[2]);
+            const T N12 = V::andOp(N[1], N[2]);
+            const T P123 = V::andOp(P12, P[3]);
+            const T N123 = V::andOp(N12, N[3]);
+            win = V::orOp(win, V::andOp(P123, P[4]));
+            win = V::orOp(win, V::andOp(N[1], P123));
+            win = V::orOp(win, V::andOp(N12, P12));
+            win = V::orOp(win, V::andOp(N123, P[1]));
+            win = V::orOp(win, V::andOp(N123, N[4]));
+
+            // Exactly l own stones backward and r forward: a run of l + r + 1
+            const T F1 = V::andNot(P[2], P[1]);
+            const T F2 = V::andNot(P[3], P12);
+            const T F3 = V::andNot(P[4], P123);
+            const T B1 = V::andNot(N[2], N[1]);
+            const T B2 = V::andNot(N[3], N12);
+            const T B3 = V::andNot(N[4], N123);
+
+            // Runs of three or four with an empty cell at either end
+            T runs = V::andNot(N[1], V::andOp(F2, V::orOp(EN[1], EP[3])));
+            runs = V::orOp(runs, V::andOp(V::andOp(B1, F1), V::orOp(EN[2], EP[2])));
+            runs = V::orOp(runs, V::andNot(P[1], V::andOp(B2, V::orOp(EN[3], EP[1]))));
+            runs = V::orOp(runs, V::andNot(N[1], V::andOp(F3, V::orOp(EN[1], EP[4]))));
+            runs = V::orOp(runs, V::andOp(V::andOp(B1, F2), V::orOp(EN[2], EP[3])));
+            runs = V::orOp(runs, V::andOp(V::andOp(B2, F1), V::orOp(EN[3], EP[2])));
+            runs = V::orOp(runs, V::andNot(P[1], V::andOp(B3, V::orOp(EN[4], EP[1]))));
+            threat = V::orOp(threat, runs);
+
+            if (!IncludeFours) continue;
+
+            // Five-cell windows through the cell with three of the other cells owned and the
+            // fourth empty: playing the cell leaves one move to five
+            T own[9], open[9];
+            for (int k = 1; k <= 4; ++k) {
+                own[4 + k] = P[k];
+                own[4 - k] = N[k];
+                open[4 + k] = EP[k];
+                open[4 - k] = EN[k];
+            }
+            for (int start = 0; start <= 4; ++start) {
+                int others[4];
+                int count = 0;
+                for (int cell = start; cell < start + 5; ++cell) {
+                    if (cell != 4) others[count++] = cell;
+                }
+                for (int gap = 0; gap < 4; ++gap) {
+                    T term = open[others[gap]];
+                    for (int k = 0; k < 4; ++k) {
+                        if (k != gap) term = V::andOp(term, own[others[k]]);
+                    }
+                    four = V::orOp(four, term);
+                }
+            }
+        }
+
+        const T empty = V::load(input.empty + row);
+        V::store(output.win + block, V::andOp(win, empty));
+        V::store(output.threat + block, V::andOp(threat, empty));
+        if (IncludeFours) {
+            V::store(output.four + block, V::andOp(four, empty));
+        }
+    }
+}
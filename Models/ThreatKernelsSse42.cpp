@@ -0,0 +1,38 @@
+//
+// Created by Samuel He on 2025/11/19.
+//
+
+// Built with SSE4.2 enabled; only called after a runtime CPU check.
+
+#include "ThreatKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace {
+#include "ThreatKernelsImpl.h"
+
+    struct Sse42Vector {
+        using Type = __m128i;
+        static constexpr int LANES = 4;
+
+        static Type zero() { return _mm_setzero_si128(); }
+        static Type load(const uint32_t* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+        static void store(uint32_t* target, const Type value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(target), value); }
+        static Type andOp(const Type a, const Type b) { return _mm_and_si128(a, b); }
+        static Type orOp(const Type a, const Type b) { return _mm_or_si128(a, b); }
+        static Type andNot(const Type a, const Type b) { return _mm_andnot_si128(a, b); }
+        static Type shift(const Type value, const int s) {
+            return s >= 0 ? _mm_srl_epi32(value, _mm_cvtsi32_si128(s)) : _mm_sll_epi32(value, _mm_cvtsi32_si128(-s));
+        }
+    };
+}
+
+void threatMasksSse42(const ThreatKernelInput& input, ThreatMasks& output, const bool includeFours) {
+    if (includeFours) {
+        threatMasksKernel<Sse42Vector, true>(input, output);
+    } else {
+        threatMasksKernel<Sse42Vector, false>(input, output);
+    }
+}
+#endif
@@ -0,0 +1,125 @@
+//
+// Created by Samuel He on 2025/11/15.
+//
+
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(const size_t sizeMB) {
+    resize(sizeMB);
+}
+
+void TranspositionTable::resize(const size_t sizeMB) {
+    // Largest power of two number of slots that fits in the budget
+    const size_t budget = std::max<size_t>(sizeMB, 1) * 1024 * 1024 / sizeof(Slot);
+    size_t count = 1;
+    while (count * 2 <= budget) {
+        count *= 2;
+    }
+
+    slots.reset(new Slot[count]());
+    slotCount = count;
+    indexMask = count - 1;
+    resetStats();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < slotCount; ++i) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+    resetStats();
+}
+
+bool TranspositionTable::probe(const uint64_t position, Entry& entry, Stats& counts) const {
+    const uint64_t key = slotKey(position);
+    const Slot& slot = slots[key & indexMask];
+    const uint64_t check = slot.check.load(std::memory_order_relaxed);
+    const uint64_t data = slot.data.load(std::memory_order_relaxed);
+    ++counts.probes;
+
+    if ((check ^ data) != key) {
+        if (data != 0) {
+            ++counts.collisions;
+        }
+        return false;
+    }
+
+    ++counts.hits;
+    entry = unpack(data);
+    return true;
+}
+
+void TranspositionTable::store(
+    const uint64_t position,
+    const int depth,
+    const Bound bound,
+    const int score,
+    const BoardPosition bestMove,
+    Stats& counts
+) {
+    const uint64_t key = slotKey(position);
+    Slot& slot = slots[key & indexMask];
+
+    // Keep a deeper result for the same position; otherwise always replace
+    const uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    const uint64_t oldCheck = slot.check.load(std::memory_order_relaxed);
+    if ((oldCheck ^ oldData) == key && unpack(oldData).depth > depth) {
+        return;
+    }
+
+    const uint64_t data = pack(depth, bound, score, bestMove);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+    ++counts.stores;
+}
+
+void TranspositionTable::addStats(const Stats& counts) {
+    probes.fetch_add(counts.probes, std::memory_order_relaxed);
+    hits.fetch_add(counts.hits, std::memory_order_relaxed);
+    collisions.fetch_add(counts.collisions, std::memory_order_relaxed);
+    stores.fetch_add(counts.stores, std::memory_order_relaxed);
+}
+
+TranspositionTable::Stats TranspositionTable::stats() const {
+    Stats result;
+    result.probes = probes.load(std::memory_order_relaxed);
+    result.hits = hits.load(std::memory_order_relaxed);
+    result.collisions = collisions.load(std::memory_order_relaxed);
+    result.stores = stores.load(std::memory_order_relaxed);
+    return result;
+}
+
+void TranspositionTable::resetStats() {
+    probes.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+    collisions.store(0, std::memory_order_relaxed);
+    stores.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(
+    const int depth,
+    const Bound bound,
+    const int score,
+    const BoardPosition bestMove
+) {
+    uint64_t data = static_cast<uint32_t>(score);
+    data |= static_cast<uint64_t>(depth & 0xFF) << 32;
+    data |= static_cast<uint64_t>(bound) << 40;
+    if (bestMove.row >= 0 && bestMove.col >= 0) {
+        data |= uint64_t(1) << 42;
+        data |= static_cast<uint64_t>(bestMove.row & 0x1F) << 43;
+        data |= static_cast<uint64_t>(bestMove.col & 0x1F) << 48;
+    }
+    return data;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(const uint64_t data) {
+    Entry entry;
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.depth = static_cast<int>((data >> 32) & 0xFF);
+    entry.bound = static_cast<Bound>((data >> 40) & 0x3);
+    if (data >> 42 & 1) {
+        entry.bestMove = {static_cast<int>((data >> 43) & 0x1F), static_cast<int>((data >> 48) & 0x1F)};
+    }
+    return entry;
+}
@@ -0,0 +1,94 @@
+//
+// Created by Samuel He on 2025/11/15.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include "Constants.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size hash table of search results, shared by all search threads.
+// Each slot stores the packed entry next to (key ^ entry); a reader accepts the slot only
+// if the two words still XOR to its key, so torn concurrent writes read as misses and no
+// lock is needed.
+class TranspositionTable {
+public:
+    enum class Bound : uint8_t {
+        Exact,
+        Lower, // Score is a lower bound (search failed high)
+        Upper  // Score is an upper bound (search failed low)
+    };
+
+    struct Entry {
+        int score = 0;
+        int depth = 0;
+        Bound bound = Bound::Exact;
+        BoardPosition bestMove{-1, -1};
+    };
+
+    struct Stats {
+        uint64_t probes = 0;
+        uint64_t hits = 0;
+        uint64_t collisions = 0; // Probed slot was occupied by a different position
+        uint64_t stores = 0;
+
+        Stats& operator+=(const Stats& other) {
+            probes += other.probes;
+            hits += other.hits;
+            collisions += other.collisions;
+            stores += other.stores;
+            return *this;
+        }
+
+        [[nodiscard]] double hitRate() const {
+            return probes ? static_cast<double>(hits) / static_cast<double>(probes) : 0.0;
+        }
+        [[nodiscard]] double collisionRate() const {
+            return probes ? static_cast<double>(collisions) / static_cast<double>(probes) : 0.0;
+        }
+    };
+
+    explicit TranspositionTable(size_t sizeMB = TT_DEFAULT_SIZE_MB);
+
+    // Reallocates the table; not safe while a search is running
+    void resize(size_t sizeMB);
+    void clear();
+
+    // Returns true and fills `entry` if the position is in the table. Probes and stores are
+    // counted in the caller's `counts`, one per search thread, so the shared table takes no
+    // writes for them; each thread adds its counts with addStats() when it finishes.
+    [[nodiscard]] bool probe(uint64_t key, Entry& entry, Stats& counts) const;
+    void store(uint64_t key, int depth, Bound bound, int score, BoardPosition bestMove, Stats& counts);
+
+    [[nodiscard]] size_t capacity() const { return slotCount; }
+    void addStats(const Stats& counts);
+    // Sum of the counts added since the last reset
+    [[nodiscard]] Stats stats() const;
+    void resetStats();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t slotCount = 0;
+    size_t indexMask = 0;
+
+    std::atomic<uint64_t> probes{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> collisions{0};
+    std::atomic<uint64_t> stores{0};
+
+    // An empty slot's words XOR to 0, so key 0 is stored as another key in the same slot
+    [[nodiscard]] static uint64_t slotKey(const uint64_t key) { return key ? key : uint64_t(1) << 63; }
+
+    // Layout: score [0, 32), depth [32, 40), bound [40, 42), has move [42], row [43, 48), col [48, 53)
+    [[nodiscard]] static uint64_t pack(int depth, Bound bound, int score, BoardPosition bestMove);
+    [[nodiscard]] static Entry unpack(uint64_t data);
+};
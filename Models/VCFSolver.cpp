@@ -0,0 +1,106 @@
+//
+// Created by Samuel He on 2025/11/20.
+//
+
+#include "VCFSolver.h"
+#include "ThreatKernels.h"
+
+template <int Size>
+BoardPosition BasicVCFSolver<Size>::findWin(BoardManager& boardManager, const char attacker) {
+    nodes = 0;
+    aborted = false;
+    line.clear();
+    if (boardManager.sideToMove() != attacker || boardManager.checkWinner() != EMPTY) {
+        return {-1, -1};
+    }
+    if (failedPositions.size() > MAX_FAILED_POSITIONS) {
+        failedPositions.clear();
+    }
+
+    if (solve(boardManager, attacker, _maxDepth)) {
+        return line.front();
+    }
+    line.clear();
+    return {-1, -1};
+}
+
+template <int Size>
+bool BasicVCFSolver<Size>::solve(BoardManager& boardManager, const char attacker, const int depth) {
+    const char defender = attacker == BLACK ? WHITE : BLACK;
+    const ThreatMasks attack = computeThreatMasks(boardManager, attacker, true);
+
+    // A five ends it
+    BoardPosition five{-1, -1};
+    if (collectThreatCells<Size>(attack.win, &five, 1)) {
+        line.push_back(five);
+        return true;
+    }
+    if (depth == 0 || nodes >= _maxNodes) {
+        return false;
+    }
+    if (stopToken && stopToken->load(std::memory_order_relaxed)) {
+        aborted = true;
+        return false;
+    }
+
+    const uint64_t key = boardManager.hash();
+    const auto failed = failedPositions.find(key);
+    if (failed != failedPositions.end() && failed->second >= depth) {
+        return false;
+    }
+
+    // A defender four must be blocked, so the attacker's four has to land on it; two can't be
+    BoardPosition defenderFives[2];
+    const int defenderFiveCount = collectThreatCells<Size>(
+        computeThreatMasks(boardManager, defender).win, defenderFives, 2
+    );
+    if (defenderFiveCount == 2) {
+        return false;
+    }
+
+    const bool won = anyThreatCell<Size>(attack.four, [&](const BoardPosition four) {
+        if (defenderFiveCount == 1 && four != defenderFives[0]) {
+            return false;
+        }
+        ++nodes;
+
+        boardManager.makeMove(four);
+        bool wins = false;
+        // The defender ignores the four if it has a five of its own
+        BoardPosition counterFive{-1, -1};
+        if (!collectThreatCells<Size>(computeThreatMasks(boardManager, defender).win, &counterFive, 1)) {
+            BoardPosition fives[2];
+            const int fiveCount = collectThreatCells<Size>(computeThreatMasks(boardManager, attacker).win, fives, 2);
+            line.push_back(four);
+            if (fiveCount == 2) {
+                // Only one of them can be blocked
+                line.push_back(fives[0]);
+                line.push_back(fives[1]);
+                wins = true;
+            } else {
+                line.push_back(fives[0]);
+                boardManager.makeMove(fives[0]);
+                wins = solve(boardManager, attacker, depth - 1);
+                boardManager.undoMove();
+                if (!wins) {
+                    line.pop_back();
+                }
+            }
+            if (!wins) {
+                line.pop_back();
+            }
+        }
+        boardManager.undoMove();
+        return wins;
+    });
+
+    // A search cut short by the node limit or the stop token proves nothing
+    if (!won && nodes < _maxNodes && !aborted) {
+        failedPositions[key] = depth;
+    }
+    return won;
+}
+
+template class BasicVCFSolver<15>;
+template class BasicVCFSolver<19>;
+template class BasicVCFSolver<20>;
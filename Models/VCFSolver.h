@@ -0,0 +1,61 @@
+//
+// Created by Samuel He on 2025/11/20.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include "Constants.h"
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Victory by Continuous Fours: searches only lines where the attacker makes a four on every
+// move, so each defender reply is forced. The branching is narrow enough to read forced
+// wins 20+ plies deep in a few milliseconds.
+template <int Size>
+class BasicVCFSolver {
+public:
+    using BoardManager = BasicBoardManager<Size>;
+
+    explicit BasicVCFSolver(int maxDepth = VCF_MAX_DEPTH, uint64_t maxNodes = VCF_MAX_NODES)
+        : _maxDepth(maxDepth), _maxNodes(maxNodes) {}
+
+    // Returns the first move of a forced win for attacker, or {-1, -1} if none was found
+    // within the depth (in attacker moves) and node limits. The attacker must be the side to
+    // move. The board is back in its original state on return.
+    BoardPosition findWin(BoardManager& boardManager, char attacker);
+
+    void setMaxDepth(int depth) { _maxDepth = depth; }
+    [[nodiscard]] int getMaxDepth() const { return _maxDepth; }
+    void setMaxNodes(uint64_t nodes) { _maxNodes = nodes; }
+    [[nodiscard]] uint64_t getMaxNodes() const { return _maxNodes; }
+    // findWin() also gives up once *token is set, e.g. by another thread; nullptr for none
+    void setStopToken(const std::atomic<bool>* token) { stopToken = token; }
+
+    // Attacker moves tried by the last findWin() call
+    [[nodiscard]] uint64_t lastNodes() const { return nodes; }
+    // The win found by the last findWin() call, attacker and defender moves alternating and
+    // ending with the five
+    [[nodiscard]] const std::vector<BoardPosition>& lastLine() const { return line; }
+
+private:
+    int _maxDepth;
+    uint64_t _maxNodes;
+    const std::atomic<bool>* stopToken = nullptr;
+
+    uint64_t nodes = 0;
+    bool aborted = false;
+    std::vector<BoardPosition> line;
+
+    // Positions already searched without finding a win, with the depth they were searched to.
+    // Kept between calls; a position's VCF doesn't depend on how it was reached.
+    std::unordered_map<uint64_t, int> failedPositions;
+    static constexpr size_t MAX_FAILED_POSITIONS = 1 << 16;
+
+    // True if the attacker, to move, wins by continuous fours within depth attacker moves
+    bool solve(BoardManager& boardManager, char attacker, int depth);
+};
+
+using VCFSolver = BasicVCFSolver<BOARD_SIZE>;
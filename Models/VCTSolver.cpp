@@ -0,0 +1,189 @@
+//
+// Created by Samuel He on 2025/11/21.
+//
+
+#include "VCTSolver.h"
+
+template <int Size>
+BoardPosition BasicVCTSolver<Size>::findWin(BoardManager& boardManager, const char attacker) {
+    nodes = 0;
+    aborted = false;
+    winningMove = {-1, -1};
+    if (boardManager.sideToMove() != attacker || boardManager.checkWinner() != EMPTY) {
+        return {-1, -1};
+    }
+    if (failedPositions.size() > MAX_FAILED_POSITIONS) {
+        failedPositions.clear();
+    }
+
+    // Deepen one attacker move at a time: short wins are found before the budget goes on
+    // long lines, and the failed positions of one pass prune the next
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeLimitMs);
+    for (int depth = 1; depth <= _maxDepth && !aborted; ++depth) {
+        if (solve(boardManager, attacker, depth)) {
+            return winningMove;
+        }
+    }
+    return {-1, -1};
+}
+
+template <int Size>
+bool BasicVCTSolver<Size>::outOfBudget() {
+    ++nodes;
+    if (nodes >= _maxNodes || (stopToken && stopToken->load(std::memory_order_relaxed))) {
+        aborted = true;
+    } else if (_timeLimitMs > 0 && nodes % TIME_CHECK_INTERVAL == 0 &&
+               std::chrono::steady_clock::now() >= deadline) {
+        aborted = true;
+    }
+    return aborted;
+}
+
+template <int Size>
+bool BasicVCTSolver<Size>::solve(BoardManager& boardManager, const char attacker, const int depth) {
+    const char defender = attacker == BLACK ? WHITE : BLACK;
+    const ThreatMasks attack = computeThreatMasks(boardManager, attacker, true);
+
+    BoardPosition five{-1, -1};
+    if (collectThreatCells<Size>(attack.win, &five, 1)) {
+        winningMove = five;
+        return true;
+    }
+    if (depth == 0 || aborted) {
+        return false;
+    }
+
+    const uint64_t key = boardManager.hash();
+    const auto failed = failedPositions.find(key);
+    if (failed != failedPositions.end() && failed->second >= depth) {
+        return false;
+    }
+
+    // A defender four must be blocked, so the attacker's move has to land on it; two can't be
+    BoardPosition defenderFives[2];
+    const int defenderFiveCount = collectThreatCells<Size>(
+        computeThreatMasks(boardManager, defender).win, defenderFives, 2
+    );
+    if (defenderFiveCount == 2) {
+        return false;
+    }
+    const auto allowed = [&](const BoardPosition move) {
+        return defenderFiveCount == 0 || move == defenderFives[0];
+    };
+
+    // Fours first: the reply is forced, so they are cheap to read
+    bool won = anyThreatCell<Size>(attack.four, [&](const BoardPosition four) {
+        if (!allowed(four) || outOfBudget()) {
+            return false;
+        }
+
+        boardManager.makeMove(four);
+        bool wins = false;
+        BoardPosition counterFive{-1, -1};
+        if (!collectThreatCells<Size>(computeThreatMasks(boardManager, defender).win, &counterFive, 1)) {
+            BoardPosition fives[2];
+            const int fiveCount = collectThreatCells<Size>(computeThreatMasks(boardManager, attacker).win, fives, 2);
+            if (fiveCount == 2) {
+                wins = true;
+            } else {
+                boardManager.makeMove(fives[0]);
+                wins = solve(boardManager, attacker, depth - 1);
+                boardManager.undoMove();
+            }
+        }
+        boardManager.undoMove();
+        if (wins) {
+            winningMove = four;
+        }
+        return wins;
+    });
+
+    // Then threes, which must hold against every defence
+    if (!won && depth > 1) {
+        won = anyThreatCell<Size>(attack.threat, [&](const BoardPosition three) {
+            if (attack.makesFour(three) || !allowed(three) || outOfBudget()) {
+                return false;
+            }
+
+            boardManager.makeMove(three);
+            bool wins = false;
+            BoardPosition counterFive{-1, -1};
+            if (!collectThreatCells<Size>(computeThreatMasks(boardManager, defender).win, &counterFive, 1)) {
+                BoardPosition replies[BoardManager::CELL_COUNT];
+                const int replyCount = threatReplies(boardManager, attacker, attack, replies);
+                wins = replyCount > 0;
+                for (int i = 0; wins && i < replyCount; ++i) {
+                    boardManager.makeMove(replies[i]);
+                    wins = solve(boardManager, attacker, depth - 1);
+                    boardManager.undoMove();
+                }
+            }
+            boardManager.undoMove();
+            if (wins) {
+                winningMove = three;
+            }
+            return wins;
+        });
+    }
+
+    // A search cut short by the budget proves nothing
+    if (!won && !aborted) {
+        failedPositions[key] = depth;
+    }
+    return won;
+}
+
+template <int Size>
+int BasicVCTSolver<Size>::threatReplies(
+    const BoardManager& boardManager,
+    const char attacker,
+    const ThreatMasks& before,
+    BoardPosition* replies
+) {
+    const char defender = attacker == BLACK ? WHITE : BLACK;
+    const ThreatMasks after = computeThreatMasks(boardManager, attacker, true);
+
+    uint32_t newFours[THREAT_KERNEL_MAX_SIZE] = {};
+    for (int row = 0; row < Size; ++row) {
+        newFours[row] = after.four[row] & ~before.four[row];
+    }
+
+    // Taking a four cell stops that straight four, as does taking one of its five cells. The
+    // threat is real if at least one of the new fours would leave two fives to block.
+    uint32_t replyMask[THREAT_KERNEL_MAX_SIZE] = {};
+    bool real = false;
+    ThreatKernelInput input = threatKernelInput(boardManager, attacker);
+    anyThreatCell<Size>(newFours, [&](const BoardPosition four) {
+        const uint32_t bit = uint32_t(1) << four.col;
+        input.own[THREAT_KERNEL_PADDING + four.row] |= bit;
+        input.empty[THREAT_KERNEL_PADDING + four.row] &= ~bit;
+        ThreatMasks next;
+        computeThreatMasks(input, next);
+        input.own[THREAT_KERNEL_PADDING + four.row] &= ~bit;
+        input.empty[THREAT_KERNEL_PADDING + four.row] |= bit;
+
+        replyMask[four.row] |= bit;
+        BoardPosition fives[2];
+        if (collectThreatCells<Size>(next.win, fives, 2) == 2) {
+            real = true;
+            for (int row = 0; row < Size; ++row) {
+                replyMask[row] |= next.win[row];
+            }
+        }
+        return false;
+    });
+    if (!real) {
+        return 0;
+    }
+
+    // A counter-four makes the attacker answer first
+    const ThreatMasks defence = computeThreatMasks(boardManager, defender, true);
+    for (int row = 0; row < Size; ++row) {
+        replyMask[row] |= defence.four[row];
+    }
+    return collectThreatCells<Size>(replyMask, replies, BoardManager::CELL_COUNT);
+}
+
+template class BasicVCTSolver<15>;
+template class BasicVCTSolver<19>;
+template class BasicVCTSolver<20>;
@@ -0,0 +1,82 @@
+//
+// Created by Samuel He on 2025/11/21.
+//
+
+#pragma once
+
+#include "BoardManager.h"
+#include "Constants.h"
+#include "ThreatKernels.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+// Victory by Continuous Threats: like the VCF solver, but the attacker may also make an open
+// three, a threat that wins by a straight four unless answered. The defender then only tries
+// the cells that stop the straight four, plus fours of its own. The search is much wider than
+// VCF, so besides depth it is bounded by a node count and a wall-clock limit.
+template <int Size>
+class BasicVCTSolver {
+public:
+    using BoardManager = BasicBoardManager<Size>;
+
+    explicit BasicVCTSolver(
+        int maxDepth = VCT_MAX_DEPTH,
+        uint64_t maxNodes = VCT_MAX_NODES,
+        int timeLimitMs = VCT_TIME_LIMIT_MS
+    ) : _maxDepth(maxDepth), _maxNodes(maxNodes), _timeLimitMs(timeLimitMs) {}
+
+    // Returns the first move of a forced win for attacker, or {-1, -1} if none was found
+    // within the limits. The attacker must be the side to move. The board is back in its
+    // original state on return.
+    BoardPosition findWin(BoardManager& boardManager, char attacker);
+
+    void setMaxDepth(int depth) { _maxDepth = depth; }
+    [[nodiscard]] int getMaxDepth() const { return _maxDepth; }
+    void setMaxNodes(uint64_t nodes) { _maxNodes = nodes; }
+    [[nodiscard]] uint64_t getMaxNodes() const { return _maxNodes; }
+    void setTimeLimit(int milliseconds) { _timeLimitMs = milliseconds; }
+    [[nodiscard]] int getTimeLimit() const { return _timeLimitMs; }
+    // findWin() also gives up once *token is set, e.g. by another thread; nullptr for none
+    void setStopToken(const std::atomic<bool>* token) { stopToken = token; }
+
+    // Attacker moves tried by the last findWin() call
+    [[nodiscard]] uint64_t lastNodes() const { return nodes; }
+
+    // Defender replies to the threat the attacker just played, given the attacker's masks
+    // from before it: the cells where the attacker could now make a four, the five cells of
+    // the straight fours among them, and the defender's own fours. Returns 0 if none of the new
+    // fours is a straight four, i.e. the move wasn't a real threat and could be ignored.
+    // Shared with the proof-number solver.
+    static int threatReplies(const BoardManager& boardManager, char attacker, const ThreatMasks& before,
+                             BoardPosition* replies);
+
+private:
+    int _maxDepth;
+    uint64_t _maxNodes;
+    int _timeLimitMs;
+    const std::atomic<bool>* stopToken = nullptr;
+
+    uint64_t nodes = 0;
+    bool aborted = false;
+    BoardPosition winningMove{-1, -1};
+    std::chrono::steady_clock::time_point deadline;
+
+    // Same as BasicVCFSolver::failedPositions
+    std::unordered_map<uint64_t, int> failedPositions;
+    static constexpr size_t MAX_FAILED_POSITIONS = 1 << 16;
+
+    // Reading the clock at every node is too slow; poll it once per this many nodes
+    static constexpr uint64_t TIME_CHECK_INTERVAL = 64;
+
+    // Counts an attacker move and reports whether the node or time limit has run out or the
+    // stop token was set
+    bool outOfBudget();
+
+    // True if the attacker, to move, wins by continuous threats within depth attacker moves
+    bool solve(BoardManager& boardManager, char attacker, int depth);
+
+};
+
+using VCTSolver = BasicVCTSolver<BOARD_SIZE>;
@@ -1,12 +1,230 @@
 #include "../Models/GomokuAI.h"
 #include "../Models/BoardManager.h"
+#include "../Models/Patterns.h"
+#include "../Models/ProofNumberSolver.h"
+#include "../Models/ThreatKernels.h"
+#include "../Models/VCFSolver.h"
+#include "../Models/VCTSolver.h"
 
+#include <algorithm>
 #include <thread>
 #include <future>
 #include <chrono>
 #include <iostream>
+#include <random>
+#include <vector>
 
-// Tests for testing whether the overhead of creating threads outweighs the benefits
+// Tests for testing whether the overhead of creating threads outweighs the benefits,
+// preceded by deterministic correctness checks that make the executable fail on a regression
+
+struct GomokuAITestAccess {
+    static int evaluate(const GomokuAI& ai, const BoardManager& boardManager, const char player) {
+        return ai.evaluate(boardManager, player);
+    }
+
+    // Exact score of a fixed-depth search for the side to move, from an empty table
+    static int searchScore(GomokuAI& ai, BoardManager& boardManager, const int depth) {
+        ai.setColor(boardManager.sideToMove());
+        ai.prepareSearchContexts();
+        ai.searchStop.store(false);
+        return ai.searchRoot(boardManager, depth, {-1, -1}, -GomokuAI::INF, GomokuAI::INF).first;
+    }
+
+    // Plain fail-hard alpha-beta without a table, as the search was before PVS, scored the same
+    // way: from the side to move, with the AI's evaluation at the leaves
+    template <int Size>
+    static bool wouldWin(const BasicGomokuAI<Size>& ai, const BasicBoardManager<Size>& boardManager,
+                         const BoardPosition position, const char player) {
+        return ai.wouldWin(boardManager, position, player);
+    }
+
+    template <int Size>
+    static bool posesThreat(const BasicGomokuAI<Size>& ai, const BasicBoardManager<Size>& boardManager,
+                            const BoardPosition position, const char player) {
+        return ai.posesThreat(boardManager, position, player);
+    }
+
+    static int alphaBetaScore(const GomokuAI& ai, BoardManager& boardManager, const int depth) {
+        return alphaBeta(ai, boardManager, depth, -GomokuAI::INF, GomokuAI::INF);
+    }
+
+    static int alphaBeta(const GomokuAI& ai, BoardManager& boardManager, const int depth, int alpha, const int beta) {
+        const char sideToMove = boardManager.sideToMove();
+        const char winner = boardManager.checkWinner();
+        if (winner != EMPTY) {
+            return winner == sideToMove ? GomokuAI::WIN_SCORE + 10000 : -GomokuAI::WIN_SCORE - 10000;
+        }
+        if (depth == 0) {
+            const int score = ai.evaluate(boardManager, ai.getColor());
+            return sideToMove == ai.getColor() ? score : -score;
+        }
+
+        const auto moves = ai.candidateMoves(boardManager);
+        if (moves.empty()) {
+            return 0;
+        }
+        for (const BoardPosition move : moves) {
+            boardManager.makeMove(move);
+            const int score = -alphaBeta(ai, boardManager, depth - 1, -beta, -alpha);
+            boardManager.undoMove();
+            if (score >= beta) {
+                return beta;
+            }
+            alpha = std::max(alpha, score);
+        }
+        return alpha;
+    }
+};
+
+// Random unfinished positions played near the stones already down, the same on every run
+std::vector<std::vector<BoardPosition>> tacticalPositions(const int count, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::vector<BoardPosition>> positions;
+    while (static_cast<int>(positions.size()) < count) {
+        BoardManager board;
+        std::vector<BoardPosition> moves{{BOARD_SIZE / 2, BOARD_SIZE / 2}};
+        board.makeMove(moves.front());
+        const int length = 6 + static_cast<int>(rng() % 30);
+        for (int i = 0; i < length; ++i) {
+            const auto candidates = board.getCandidateMoves();
+            const BoardPosition move = candidates.begin()[rng() % candidates.size()];
+            if (board.makeMove(move) != EMPTY) break;
+            moves.push_back(move);
+        }
+        positions.push_back(moves);
+    }
+    return positions;
+}
+
+// Random unfinished positions, the same on every run
+std::vector<std::vector<BoardPosition>> testPositions(const int count) {
+    std::mt19937 rng(20251124);
+    std::vector<std::vector<BoardPosition>> positions;
+    while (static_cast<int>(positions.size()) < count) {
+        BoardManager board;
+        std::vector<BoardPosition> moves;
+        const int length = 1 + static_cast<int>(rng() % 60);
+        for (int i = 0; i < length; ++i) {
+            const BoardPosition move{static_cast<int>(rng() % BOARD_SIZE), static_cast<int>(rng() % BOARD_SIZE)};
+            if (!board.isValidMove(move)) continue;
+            if (board.makeMove(move) != EMPTY) break;
+            moves.push_back(move);
+        }
+        positions.push_back(moves);
+    }
+    return positions;
+}
+
+BoardManager playOut(const std::vector<BoardPosition>& moves, const int symmetry = 0) {
+    BoardManager board;
+    for (const BoardPosition move : moves) {
+        board.makeMove(BoardManager::transform(move, symmetry));
+    }
+    return board;
+}
+
+bool sameSummary(const SequenceSummary& a, const SequenceSummary& b) {
+    return a.score == b.score && a.openThrees == b.openThrees && a.semiOpenThrees == b.semiOpenThrees &&
+           a.openFours == b.openFours && a.semiOpenFours == b.semiOpenFours;
+}
+
+// Every threat kernel the CPU has must mark exactly the cells the per-cell functions report,
+// and the fours the scalar kernel marks, on random boards of each size
+template <int Size>
+bool checkThreatKernels(const unsigned seed) {
+    const BasicGomokuAI<Size> ai(BLACK);
+    const ThreatKernel original = activeThreatKernel();
+    std::mt19937 rng(seed);
+    bool passed = true;
+    for (int position = 0; position < 300 && passed; ++position) {
+        BasicBoardManager<Size> board;
+        const int length = 1 + static_cast<int>(rng() % (Size * Size / 2));
+        for (int i = 0; i < length; ++i) {
+            const BoardPosition move{static_cast<int>(rng() % Size), static_cast<int>(rng() % Size)};
+            if (!board.isValidMove(move)) continue;
+            if (board.makeMove(move) != EMPTY) break;
+        }
+
+        for (const char player : {BLACK, WHITE}) {
+            setThreatKernel(ThreatKernel::Scalar);
+            const ThreatMasks scalar = computeThreatMasks(board, player, true);
+            for (const ThreatKernel kernel : {ThreatKernel::Scalar, ThreatKernel::Sse42, ThreatKernel::Avx2}) {
+                if (!setThreatKernel(kernel)) {
+                    continue;
+                }
+                const ThreatMasks masks = computeThreatMasks(board, player, true);
+                for (int row = 0; row < Size && passed; ++row) {
+                    for (int col = 0; col < Size && passed; ++col) {
+                        const BoardPosition cell{row, col};
+                        if (masks.wins(cell) != GomokuAITestAccess::wouldWin(ai, board, cell, player) ||
+                            masks.threatens(cell) != GomokuAITestAccess::posesThreat(ai, board, cell, player) ||
+                            masks.makesFour(cell) != scalar.makesFour(cell)) {
+                            std::cerr << "FAILED: threat kernel " << static_cast<int>(kernel) << " disagrees at "
+                                      << cell << " on " << Size << "x" << Size << "\n";
+                            passed = false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    setThreatKernel(original);
+    return passed;
+}
+
+bool checkThreatKernels() {
+    if (!checkThreatKernels<15>(8) || !checkThreatKernels<19>(19) || !checkThreatKernels<20>(20)) {
+        return false;
+    }
+    std::cout << "Threat kernels match the per-cell checks on 15, 19 and 20\n";
+    return true;
+}
+
+// Every line of BOARD_SIZE cells must score the same read from either end. Shorter lines are
+// covered too, since cells off the board look like opponent stones.
+bool checkLinePatternSymmetry() {
+    constexpr int length = BOARD_SIZE;
+    int cells[length] = {}; // 0 opponent, 1 own, 2 empty
+
+    while (true) {
+        LineMask stones = 0, empty = 0, reversedStones = 0, reversedEmpty = 0;
+        for (int i = 0; i < length; ++i) {
+            const LineMask bit = LineMask{1} << i;
+            const LineMask mirrored = LineMask{1} << (length - 1 - i);
+            if (cells[i] == 1) {
+                stones |= bit;
+                reversedStones |= mirrored;
+            } else if (cells[i] == 2) {
+                empty |= bit;
+                reversedEmpty |= mirrored;
+            }
+        }
+
+        if (!sameSummary(scoreLine(stones, empty), scoreLine(reversedStones, reversedEmpty))) {
+            std::cerr << "FAILED: line scores depend on direction, stones " << stones << " empty " << empty << "\n";
+            return false;
+        }
+
+        int digit = 0;
+        while (digit < length && cells[digit] == 2) {
+            cells[digit++] = 0;
+        }
+        if (digit == length) {
+            break;
+        }
+        ++cells[digit];
+    }
+
+    // A broken shape is one threat, not a threat plus the stones past its gap
+    const SequenceSummary brokenFour = scoreLine(0b0111010, 0b1000101);
+    if (brokenFour.semiOpenFours != 1 || brokenFour.openThrees != 0) {
+        std::cerr << "FAILED: _X_XXX_ should be a single four\n";
+        return false;
+    }
+
+    std::cout << "Line patterns score the same in both directions\n";
+    return true;
+}
 
 void testAsyncOverhead() {
     using namespace std::chrono;
@@ -54,7 +272,257 @@ void testEvaluationTime() {
               << evalAvg_us << " microseconds\n";
 }
 
+// Null windows, re-searches and the table must not change the root score: with the pruning
+// heuristics off, PVS returns exactly what plain alpha-beta does
+bool checkPrincipalVariationScores() {
+    GomokuAI ai(BLACK);
+    ai.setSearchMode(SearchMode::Sequential);
+    ai.setTranspositionTableSize(1);
+    ai.setLateMoveReductions(false);
+    ai.setQuiescenceSearch(false);
+
+    for (const auto& moves : testPositions(20)) {
+        BoardManager board = playOut(moves);
+        for (int depth = 1; depth <= 3; ++depth) {
+            const int score = GomokuAITestAccess::searchScore(ai, board, depth);
+            const int expected = GomokuAITestAccess::alphaBetaScore(ai, board, depth);
+            if (score != expected) {
+                std::cerr << "FAILED: PVS scored " << score << " at depth " << depth << ", alpha-beta " << expected
+                          << "\n";
+                return false;
+            }
+        }
+    }
+
+    std::cout << "PVS scores match plain alpha-beta\n";
+    return true;
+}
+
+// A VCF line must be playable as given: every defender move the only block of a four, and
+// the last attacker move a five
+bool checkVcfLines() {
+    VCFSolver solver;
+    int wins = 0;
+    for (const auto& moves : tacticalPositions(400, 14)) {
+        BoardManager board = playOut(moves);
+        const char attacker = board.sideToMove();
+        if (solver.findWin(board, attacker).row < 0) {
+            continue;
+        }
+        ++wins;
+
+        const std::vector<BoardPosition> line = solver.lastLine();
+        char winner = EMPTY;
+        for (size_t i = 0; i < line.size(); ++i) {
+            const bool defenderMove = i % 2 == 1;
+            if (!board.isValidMove(line[i]) || winner != EMPTY ||
+                (defenderMove && !computeThreatMasks(board, attacker).wins(line[i]))) {
+                std::cerr << "FAILED: VCF line breaks at move " << i << "\n";
+                return false;
+            }
+            winner = board.makeMove(line[i]);
+        }
+        if (winner != attacker || line.size() % 2 == 0) {
+            std::cerr << "FAILED: VCF line doesn't end in the attacker's five\n";
+            return false;
+        }
+    }
+    if (wins < 10) {
+        std::cerr << "FAILED: only " << wins << " VCF wins to replay\n";
+        return false;
+    }
+
+    std::cout << "VCF lines replay to a win (" << wins << " positions)\n";
+    return true;
+}
+
+// A VCT win is a tree, not a line, so play it out: the attacker follows the solver, which must
+// keep finding the win, against an engine or a random defender, and has to make five
+bool checkVctWins() {
+    VCTSolver solver;
+    solver.setTimeLimit(0); // Node limit only, so every run searches the same trees
+
+    GomokuAI defender(BLACK, 2);
+    defender.setSearchMode(SearchMode::Sequential);
+    defender.setTranspositionTableSize(1);
+    defender.setForcedWinPreCheck(false);
+    std::mt19937 rng(15);
+
+    int wins = 0;
+    for (const auto& moves : tacticalPositions(60, 15)) {
+        BoardManager board = playOut(moves);
+        const char attacker = board.sideToMove();
+        if (solver.findWin(board, attacker).row < 0) {
+            continue;
+        }
+        const bool randomDefender = ++wins % 2 == 0;
+        defender.setColor(attacker == BLACK ? WHITE : BLACK);
+
+        char winner = EMPTY;
+        for (int ply = 0; winner == EMPTY && !board.isBoardFull() && ply < 4 * VCT_MAX_DEPTH; ++ply) {
+            BoardPosition move;
+            if (board.sideToMove() == attacker) {
+                move = solver.findWin(board, attacker);
+                if (move.row < 0) {
+                    std::cerr << "FAILED: VCT lost its win after " << ply << " plies\n";
+                    return false;
+                }
+            } else if (randomDefender) {
+                const auto candidates = board.getCandidateMoves();
+                move = candidates.begin()[rng() % candidates.size()];
+            } else {
+                move = defender.getBestMove(board);
+            }
+            winner = board.makeMove(move);
+        }
+        if (winner != attacker) {
+            std::cerr << "FAILED: VCT win wasn't converted\n";
+            return false;
+        }
+    }
+    if (wins < 10) {
+        std::cerr << "FAILED: only " << wins << " VCT wins to play out\n";
+        return false;
+    }
+
+    std::cout << "VCT wins play out to a five (" << wins << " positions)\n";
+    return true;
+}
+
+// df-pn searches the VCT threat space without its depth bound, so a position it disproves
+// within twice the VCT depth in plies must have no VCT win. The ply limit is tight on purpose:
+// cut-offs at the limit read as disproofs and must not leak to other positions.
+bool checkProofNumberDisproofs() {
+    ProofNumberSolver prover;
+    prover.setMaxPly(2 * VCT_MAX_DEPTH);
+    VCTSolver solver;
+    solver.setTimeLimit(0);
+
+    int disproven = 0;
+    int proven = 0;
+    for (const auto& moves : tacticalPositions(100, 16)) {
+        BoardManager board = playOut(moves);
+        const char attacker = board.sideToMove();
+        const auto result = prover.prove(board, attacker);
+        proven += result == ProofNumberSolver::Result::Proven;
+        if (result != ProofNumberSolver::Result::Disproven) {
+            continue;
+        }
+        ++disproven;
+        if (solver.findWin(board, attacker).row >= 0) {
+            std::cerr << "FAILED: df-pn disproved a position the VCT solver wins\n";
+            return false;
+        }
+    }
+    if (disproven < 10 || proven < 10) {
+        std::cerr << "FAILED: only " << proven << " proofs and " << disproven << " disproofs to check\n";
+        return false;
+    }
+
+    std::cout << "df-pn disproofs agree with the VCT solver (" << disproven << " positions)\n";
+    return true;
+}
+
+// The totals BoardManager keeps up to date on make/undo must equal a scan of every stone,
+// the way evaluate() computed them before they were incremental
+bool checkIncrementalEvaluation() {
+    const GomokuAI ai(WHITE);
+    std::mt19937 rng(4);
+    for (int game = 0; game < 200; ++game) {
+        BoardManager board;
+        for (int step = 0; step < 80; ++step) {
+            if (board.movesPlayed() > 0 && rng() % 4 == 0) {
+                board.undoMove();
+            } else {
+                const auto candidates = board.getCandidateMoves();
+                const BoardPosition move = candidates.empty()
+                    ? BoardPosition{BOARD_SIZE / 2, BOARD_SIZE / 2}
+                    : candidates.begin()[rng() % candidates.size()];
+                if (board.makeMove(move) != EMPTY) {
+                    break;
+                }
+            }
+
+            for (const char player : {BLACK, WHITE}) {
+                SequenceSummary scanned;
+                int centerBias = 0;
+                for (int row = 0; row < BOARD_SIZE; ++row) {
+                    for (int col = 0; col < BOARD_SIZE; ++col) {
+                        scanned += ai.evaluateForPlayerAtPos(board, player, row, col);
+                        if (board.getCell(row, col) == player) {
+                            centerBias += std::max(1, BOARD_SIZE - board.centerManhattanDistance[row][col]);
+                        }
+                    }
+                }
+                if (!sameSummary(board.sequenceSummary(player), scanned) || board.centerBias(player) != centerBias) {
+                    std::cerr << "FAILED: incremental evaluation differs from a full scan after "
+                              << board.movesPlayed() << " moves\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    std::cout << "Incremental evaluation matches a full scan\n";
+    return true;
+}
+
+// Symmetric search shares table entries between the eight images of a position, which needs
+// their keys to be the images' own keys and their evaluations to agree
+bool checkSymmetricImages() {
+    const GomokuAI ai(WHITE);
+    for (const auto& moves : testPositions(500)) {
+        const BoardManager board = playOut(moves);
+        for (int symmetry = 0; symmetry < BoardManager::SYMMETRIES; ++symmetry) {
+            const BoardManager image = playOut(moves, symmetry);
+            if (board.symmetricHash(symmetry) != image.hash()) {
+                std::cerr << "FAILED: symmetric key " << symmetry << " differs from the transformed board's key\n";
+                return false;
+            }
+            for (const char player : {BLACK, WHITE}) {
+                if (GomokuAITestAccess::evaluate(ai, board, player) != GomokuAITestAccess::evaluate(ai, image, player)) {
+                    std::cerr << "FAILED: evaluation differs under symmetry " << symmetry << "\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    // The search over those images must agree as well, or sharing their entries changes scores.
+    // Reductions and the quiescence node budget depend on the move order, so they are off.
+    GomokuAI searcher(BLACK);
+    searcher.setSearchMode(SearchMode::Sequential);
+    searcher.setTranspositionTableSize(1);
+    searcher.setLateMoveReductions(false);
+    searcher.setQuiescenceSearch(false);
+    for (const auto& moves : testPositions(20)) {
+        BoardManager board = playOut(moves);
+        const int score = GomokuAITestAccess::searchScore(searcher, board, 2);
+        for (int symmetry = 1; symmetry < BoardManager::SYMMETRIES; ++symmetry) {
+            BoardManager image = playOut(moves, symmetry);
+            if (GomokuAITestAccess::searchScore(searcher, image, 2) != score) {
+                std::cerr << "FAILED: search score differs under symmetry " << symmetry << "\n";
+                return false;
+            }
+        }
+    }
+
+    std::cout << "Symmetric keys, evaluations and search scores match the transformed boards\n";
+    return true;
+}
+
 int main() {
+    bool passed = checkLinePatternSymmetry();
+    passed &= checkThreatKernels();
+    passed &= checkIncrementalEvaluation();
+    passed &= checkSymmetricImages();
+    passed &= checkPrincipalVariationScores();
+    passed &= checkVcfLines();
+    passed &= checkVctWins();
+    passed &= checkProofNumberDisproofs();
+
     testAsyncOverhead();
     testEvaluationTime();
+
+    return passed ? 0 : 1;
 }
\ No newline at end of file
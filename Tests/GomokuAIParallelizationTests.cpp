@@ -4,6 +4,7 @@
 
 #include "../Models/GomokuAI.h"
 #include "../Models/BoardManager.h"
+#include "../Models/BoardSize.h"
 #include "../Models/Constants.h"
 
 #include <future>
@@ -85,8 +86,12 @@ namespace {
 		return scenarios;
 	}
 
-	void runScenario(const Scenario& scenario) {
+	// timeBudgetMs > 0 searches iteratively until the budget is spent instead of to MAX_DEPTH
+	void runScenario(const Scenario& scenario, int timeBudgetMs = 0) {
 		GomokuAI ai(scenario.aiColor);
+		ai.setTimeBudget(timeBudgetMs);
+		// Fixed-depth runs time the search alone, without the forced-win solvers in front
+		ai.setForcedWinPreCheck(timeBudgetMs > 0);
 
 		const auto start = std::chrono::steady_clock::now();
 		const BoardPosition bestMove = ai.getBestMove(scenario.board);
@@ -103,10 +108,37 @@ namespace {
         //     return;
         // }
 
+		const auto ttStats = ai.transpositionTableStats();
+
 		std::cout << "Scenario: " << scenario.name << "\n"
 				  << "  AI color      : " << colorName << "\n"
 				  << "  Best move     : (" << bestMove.row << ", " << bestMove.col << ")\n"
-				  << "  Elapsed (ms)  : " << std::fixed << std::setprecision(2) << elapsedMs.count() << "\n\n";
+				  << "  Elapsed (ms)  : " << std::fixed << std::setprecision(2) << elapsedMs.count() << "\n"
+				  << "  Depth reached : " << ai.lastSearchDepth() << "\n"
+				  << "  Nodes         : " << ai.lastSearchNodes() << "\n"
+				  << "  TT hit rate   : " << ttStats.hitRate() * 100.0 << "%\n"
+				  << "  TT collisions : " << ttStats.collisionRate() * 100.0 << "%\n\n";
+	}
+
+	// Same reply to a center opening on every compiled board size
+	void runCenterOpeningOnEveryBoardSize() {
+		for (const int size : SUPPORTED_BOARD_SIZES) {
+			visitBoardSize(size, [](auto boardSize) {
+				constexpr int N = decltype(boardSize)::value;
+				BasicBoardManager<N> board;
+				board.makeMove({N / 2, N / 2});
+				BasicGomokuAI<N> ai(WHITE);
+
+				const auto start = std::chrono::steady_clock::now();
+				const BoardPosition bestMove = ai.getBestMove(board);
+				const auto stop = std::chrono::steady_clock::now();
+				const auto elapsedMs = std::chrono::duration<double, std::milli>(stop - start);
+
+				std::cout << "Board " << N << "x" << N << " center opening\n"
+						  << "  Best move     : (" << bestMove.row << ", " << bestMove.col << ")\n"
+						  << "  Elapsed (ms)  : " << std::fixed << std::setprecision(2) << elapsedMs.count() << "\n\n";
+			});
+		}
 	}
 
 	void testThreadCreationOverhead() {
@@ -165,6 +197,13 @@ int main() {
         runScenario(scenario);
     }
 
+    std::cout << "Time-budgeted search (" << AI_TIME_BUDGET_MS << " ms per move)...\n\n";
+    for (const auto& scenario : scenarios) {
+        runScenario(scenario, AI_TIME_BUDGET_MS);
+    }
+
+    runCenterOpeningOnEveryBoardSize();
+
     std::cout << "Done." << std::endl;
     return 0;
 }
@@ -0,0 +1,346 @@
+#include "../Models/GomokuAI.h"
+#include "../Models/BoardManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Micro-benchmarks for the board and evaluation hot paths.
+//
+//   GomokuBenchmarks [--json out.json] [--filter text] [--reps N] [--warmup N] [--sample-ms N]
+//   GomokuBenchmarks --compare baseline.json current.json [--threshold percent]
+//
+// Every benchmark runs on an opening, a midgame and a crowded endgame position. A benchmark
+// first doubles its batch size until one batch takes --sample-ms, runs --warmup untimed
+// batches, then times --reps batches. The summary is over those repetitions, in ns per call.
+// --compare matches benchmarks by name and exits with 1 if any median got slower by more than
+// the threshold.
+
+// Friend of GomokuAI, forwarding to the private methods under test
+struct GomokuAIBenchmarkAccess {
+    static std::vector<BoardPosition> candidateMoves(const GomokuAI& ai, const BoardManager& boardManager) {
+        return ai.candidateMoves(boardManager);
+    }
+    static int evaluate(const GomokuAI& ai, const BoardManager& boardManager) {
+        return ai.evaluate(boardManager, ai.getColor());
+    }
+    static bool wouldWin(const GomokuAI& ai, const BoardManager& boardManager, const BoardPosition position) {
+        return ai.wouldWin(boardManager, position, ai.getColor());
+    }
+    static bool posesThreat(const GomokuAI& ai, const BoardManager& boardManager, const BoardPosition position) {
+        return ai.posesThreat(boardManager, position, ai.getColor());
+    }
+};
+
+namespace {
+    struct Options {
+        std::string jsonPath;
+        std::string filter;
+        int repetitions = 20;
+        int warmupBatches = 3;
+        double sampleMs = 5;
+        // --compare
+        std::string baselinePath;
+        std::string currentPath;
+        double thresholdPercent = 5;
+    };
+
+    struct Summary {
+        double minNs = 0;
+        double medianNs = 0;
+        double meanNs = 0;
+        double maxNs = 0;
+        double stddevNs = 0;
+        int repetitions = 0;
+    };
+
+    struct Result {
+        std::string name;
+        Summary summary;
+    };
+
+    // Results are folded in here so the compiler can't drop the calls
+    volatile uint64_t sink = 0;
+
+    Summary summarize(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        Summary summary;
+        summary.repetitions = static_cast<int>(samples.size());
+        summary.minNs = samples.front();
+        summary.maxNs = samples.back();
+        const size_t middle = samples.size() / 2;
+        summary.medianNs = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+
+        double sum = 0;
+        for (const double sample : samples) sum += sample;
+        summary.meanNs = sum / samples.size();
+        double squares = 0;
+        for (const double sample : samples) squares += (sample - summary.meanNs) * (sample - summary.meanNs);
+        summary.stddevNs = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0;
+        return summary;
+    }
+
+    template <typename Operation>
+    Summary measure(const Options& options, Operation& operation) {
+        using Clock = std::chrono::steady_clock;
+        auto timeBatch = [&](const uint64_t calls) {
+            uint64_t folded = 0;
+            const auto start = Clock::now();
+            for (uint64_t i = 0; i < calls; ++i) {
+                folded += operation();
+            }
+            const auto elapsed = Clock::now() - start;
+            sink = sink + folded;
+            return std::chrono::duration<double, std::nano>(elapsed).count();
+        };
+
+        const double sampleNs = options.sampleMs * 1e6;
+        uint64_t batch = 1;
+        while (timeBatch(batch) < sampleNs && batch < (uint64_t(1) << 32)) {
+            batch *= 2;
+        }
+        for (int i = 0; i < options.warmupBatches; ++i) {
+            timeBatch(batch);
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < options.repetitions; ++i) {
+            samples.push_back(timeBatch(batch) / batch);
+        }
+        return summarize(samples);
+    }
+
+    // Plays random moves next to the stones already down until the board holds `stones`,
+    // taking back any move that ends the game
+    BoardManager randomPosition(const int stones, const unsigned seed) {
+        std::mt19937 rng(seed);
+        BoardManager board;
+        board.makeMove({BoardManager::size / 2, BoardManager::size / 2});
+        for (int attempts = 0; board.movesPlayed() < stones && attempts < 100 * stones; ++attempts) {
+            const auto candidates = board.getCandidateMoves();
+            const BoardPosition move = *(candidates.begin() + rng() % candidates.size());
+            if (board.makeMove(move) != EMPTY) {
+                board.undoMove();
+            }
+        }
+        return board;
+    }
+
+    struct Position {
+        const char* name;
+        BoardManager board;
+    };
+
+    std::vector<Position> benchmarkPositions() {
+        return {
+            {"opening", randomPosition(6, 1)},
+            {"midgame", randomPosition(BoardManager::CELL_COUNT / 6, 2)},
+            {"endgame", randomPosition(BoardManager::CELL_COUNT * 2 / 3, 3)},
+        };
+    }
+
+    void printRow(const Result& result) {
+        const Summary& s = result.summary;
+        std::cout << std::left << std::setw(34) << result.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << s.medianNs << std::setw(12) << s.meanNs << std::setw(12) << s.minNs
+                  << std::setw(12) << s.maxNs << std::setw(10) << s.stddevNs << std::endl;
+    }
+
+    std::vector<Result> runBenchmarks(const Options& options) {
+        std::vector<Result> results;
+        std::cout << std::left << std::setw(34) << "benchmark (ns/call)" << std::right << std::setw(12) << "median"
+                  << std::setw(12) << "mean" << std::setw(12) << "min" << std::setw(12) << "max"
+                  << std::setw(10) << "stddev" << std::endl;
+
+        for (const Position& position : benchmarkPositions()) {
+            const BoardManager& board = position.board;
+            const auto view = board.getCandidateMoves();
+            const std::vector<BoardPosition> cells(view.begin(), view.end());
+            const GomokuAI ai(board.sideToMove());
+
+            auto run = [&](const std::string& name, auto operation) {
+                const std::string fullName = name + "/" + position.name;
+                if (fullName.find(options.filter) == std::string::npos) {
+                    return;
+                }
+                results.push_back({fullName, measure(options, operation)});
+                printRow(results.back());
+            };
+
+            // One call visits one candidate cell, cycling through them all
+            run("makeMove+undoMove", [&cells, copy = board, i = size_t(0)]() mutable {
+                copy.makeMove(cells[i++ % cells.size()]);
+                copy.undoMove();
+                return copy.hash();
+            });
+            run("checkWinner", [&board] {
+                return uint64_t(board.checkWinner());
+            });
+            run("getCandidateMoves", [&board] {
+                uint64_t sum = 0;
+                for (const BoardPosition& cell : board.getCandidateMoves()) sum += cell.row * 31 + cell.col;
+                return sum;
+            });
+            run("candidateMoves", [&ai, &board] {
+                return uint64_t(GomokuAIBenchmarkAccess::candidateMoves(ai, board).size());
+            });
+            run("evaluate", [&ai, &board] {
+                return uint64_t(GomokuAIBenchmarkAccess::evaluate(ai, board));
+            });
+            run("wouldWin", [&ai, &board, &cells, i = size_t(0)]() mutable {
+                return uint64_t(GomokuAIBenchmarkAccess::wouldWin(ai, board, cells[i++ % cells.size()]));
+            });
+            run("posesThreat", [&ai, &board, &cells, i = size_t(0)]() mutable {
+                return uint64_t(GomokuAIBenchmarkAccess::posesThreat(ai, board, cells[i++ % cells.size()]));
+            });
+            // Into a live heap object, so the copy can't be optimized down to the fields read
+            run("boardCopy", [&board, target = std::make_shared<BoardManager>()] {
+                *target = board;
+                return target->hash();
+            });
+        }
+        return results;
+    }
+
+    bool writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return false;
+        }
+        out << "{\n  \"boardSize\": " << BoardManager::size << ",\n  \"benchmarks\": [\n";
+        out << std::setprecision(6);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Summary& s = results[i].summary;
+            out << "    {\"name\": \"" << results[i].name << "\", \"median_ns\": " << s.medianNs
+                << ", \"mean_ns\": " << s.meanNs << ", \"min_ns\": " << s.minNs << ", \"max_ns\": " << s.maxNs
+                << ", \"stddev_ns\": " << s.stddevNs << ", \"repetitions\": " << s.repetitions << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return true;
+    }
+
+    // Reads the name and median of every benchmark in a file written by writeJson()
+    bool readJson(const std::string& path, std::vector<Result>& results) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "Cannot read " << path << std::endl;
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        const std::string nameKey = "\"name\": \"";
+        const std::string medianKey = "\"median_ns\": ";
+        for (size_t at = text.find(nameKey); at != std::string::npos; at = text.find(nameKey, at)) {
+            at += nameKey.size();
+            const size_t nameEnd = text.find('"', at);
+            const size_t median = text.find(medianKey, nameEnd);
+            if (nameEnd == std::string::npos || median == std::string::npos) {
+                break;
+            }
+            Result result;
+            result.name = text.substr(at, nameEnd - at);
+            result.summary.medianNs = std::strtod(text.c_str() + median + medianKey.size(), nullptr);
+            results.push_back(result);
+            at = median;
+        }
+        if (results.empty()) {
+            std::cerr << "No benchmarks in " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    int compare(const Options& options) {
+        std::vector<Result> baseline;
+        std::vector<Result> current;
+        if (!readJson(options.baselinePath, baseline) || !readJson(options.currentPath, current)) {
+            return 2;
+        }
+
+        std::cout << std::left << std::setw(34) << "benchmark (median ns/call)" << std::right << std::setw(12)
+                  << "baseline" << std::setw(12) << "current" << std::setw(10) << "change" << std::endl;
+        int regressions = 0;
+        for (const Result& now : current) {
+            const auto before = std::find_if(baseline.begin(), baseline.end(), [&](const Result& result) {
+                return result.name == now.name;
+            });
+            if (before == baseline.end() || before->summary.medianNs <= 0) {
+                continue;
+            }
+            const double change = (now.summary.medianNs / before->summary.medianNs - 1) * 100;
+            const bool regressed = change > options.thresholdPercent;
+            regressions += regressed;
+            std::cout << std::left << std::setw(34) << now.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << before->summary.medianNs << std::setw(12) << now.summary.medianNs
+                      << std::setw(9) << std::showpos << change << "%" << std::noshowpos
+                      << (regressed ? "  REGRESSION" : "") << std::endl;
+        }
+        std::cout << regressions << " regression(s) above " << options.thresholdPercent << "%" << std::endl;
+        return regressions ? 1 : 0;
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (std::strcmp(argv[i], "--compare") == 0 && i + 2 < argc) {
+                options.baselinePath = argv[i + 1];
+                options.currentPath = argv[i + 2];
+                i += 2;
+                continue;
+            }
+            if (!value) {
+                return false;
+            }
+            if (std::strcmp(argv[i], "--json") == 0) {
+                options.jsonPath = value;
+            } else if (std::strcmp(argv[i], "--filter") == 0) {
+                options.filter = value;
+            } else if (std::strcmp(argv[i], "--reps") == 0) {
+                options.repetitions = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--warmup") == 0) {
+                options.warmupBatches = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--sample-ms") == 0) {
+                options.sampleMs = std::atof(value);
+            } else if (std::strcmp(argv[i], "--threshold") == 0) {
+                options.thresholdPercent = std::atof(value);
+            } else {
+                return false;
+            }
+            ++i;
+        }
+        return options.repetitions >= 1 && options.warmupBatches >= 0 && options.sampleMs > 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--json out.json] [--filter text] [--reps N] [--warmup N]"
+                  << " [--sample-ms N]\n       " << argv[0]
+                  << " --compare baseline.json current.json [--threshold percent]\n";
+        return 2;
+    }
+    if (!options.baselinePath.empty()) {
+        return compare(options);
+    }
+
+    const std::vector<Result> results = runBenchmarks(options);
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,413 @@
+//
+// Created by Samuel He on 2025/11/24.
+//
+
+#include "../Models/BoardManager.h"
+#include "../Models/BoardSize.h"
+#include "../Models/GomokuAI.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Plays engine-vs-engine games between two configurations, several at once, and reports the
+// score, an Elo estimate and, when asked, a sequential probability ratio test.
+//
+// Games come in pairs that share a random opening, each engine playing black once, so neither
+// the opening nor the first move favours a side. Engine specs are comma-separated key=value
+// lists, e.g. "depth=6,time=500,lmr=0"; see printUsage() for the keys.
+
+namespace {
+    struct EngineConfig {
+        int depth = MAX_DEPTH;
+        int timeMs = AI_TIME_BUDGET_MS; // 0 searches exactly depth
+        int threads = 1;
+        SearchMode mode = SearchMode::Sequential;
+        size_t tableSizeMB = TT_DEFAULT_SIZE_MB;
+        bool quiescence = true;
+        bool quiescenceThrees = false;
+        bool lateMoveReductions = true;
+        bool nullMovePruning = false;
+        bool proofNumberSearch = false;
+        bool vcfAtLeaves = false;
+        bool forcedWinPreCheck = true;
+        EvaluationWeights weights;
+    };
+
+    struct Options {
+        EngineConfig engines[2];
+        int games = 100;
+        int concurrency = std::max(1u, std::thread::hardware_concurrency());
+        int boardSize = BOARD_SIZE;
+        int openingPlies = 4;
+        uint64_t seed = 1;
+        bool sprt = false;
+        double elo0 = 0;
+        double elo1 = 10;
+        double alpha = 0.05;
+        double beta = 0.05;
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " --a SPEC --b SPEC [--games N] [--concurrency N] [--size N]\n"
+                  << "       [--opening-plies N] [--seed N] [--sprt ELO0,ELO1] [--alpha P] [--beta P]\n"
+                  << "SPEC keys: depth, time (ms, 0 = fixed depth), threads, tt (MB),\n"
+                  << "           mode (sequential|rootsplit|lazysmp|ybwc), qs, qthrees, lmr, null, pn, vcfleaves,\n"
+                  << "           prechecks, openFour, extraOpenFour, openThree, doubleOpenThree,\n"
+                  << "           semiOpenThree, semiOpenFour, center\n";
+    }
+
+    bool parseMode(const std::string& value, SearchMode& mode) {
+        if (value == "sequential") mode = SearchMode::Sequential;
+        else if (value == "rootsplit") mode = SearchMode::RootSplit;
+        else if (value == "lazysmp") mode = SearchMode::LazySMP;
+        else if (value == "ybwc") mode = SearchMode::YoungBrothersWait;
+        else return false;
+        return true;
+    }
+
+    bool parseEngine(const std::string& spec, EngineConfig& config) {
+        std::istringstream fields(spec);
+        std::string field;
+        while (std::getline(fields, field, ',')) {
+            const size_t equals = field.find('=');
+            if (equals == std::string::npos) {
+                std::cerr << "Expected key=value, got \"" << field << "\"" << std::endl;
+                return false;
+            }
+            const std::string key = field.substr(0, equals);
+            const std::string value = field.substr(equals + 1);
+            const int number = std::atoi(value.c_str());
+            EvaluationWeights& weights = config.weights;
+
+            if (key == "mode") {
+                if (!parseMode(value, config.mode)) {
+                    std::cerr << "Unknown search mode \"" << value << "\"" << std::endl;
+                    return false;
+                }
+            }
+            else if (key == "depth") config.depth = number;
+            else if (key == "time") config.timeMs = number;
+            else if (key == "threads") config.threads = number;
+            else if (key == "tt") config.tableSizeMB = static_cast<size_t>(number);
+            else if (key == "qs") config.quiescence = number != 0;
+            else if (key == "qthrees") config.quiescenceThrees = number != 0;
+            else if (key == "lmr") config.lateMoveReductions = number != 0;
+            else if (key == "null") config.nullMovePruning = number != 0;
+            else if (key == "pn") config.proofNumberSearch = number != 0;
+            else if (key == "vcfleaves") config.vcfAtLeaves = number != 0;
+            else if (key == "prechecks") config.forcedWinPreCheck = number != 0;
+            else if (key == "openFour") weights.openFour = number;
+            else if (key == "extraOpenFour") weights.extraOpenFour = number;
+            else if (key == "openThree") weights.openThree = number;
+            else if (key == "doubleOpenThree") weights.doubleOpenThree = number;
+            else if (key == "semiOpenThree") weights.semiOpenThree = number;
+            else if (key == "semiOpenFour") weights.semiOpenFour = number;
+            else if (key == "center") weights.center = number;
+            else {
+                std::cerr << "Unknown engine option \"" << key << "\"" << std::endl;
+                return false;
+            }
+        }
+        return config.depth >= 1 && config.timeMs >= 0 && config.threads >= 1;
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        bool haveEngine[2] = {false, false};
+        for (int i = 1; i < argc; ++i) {
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (!value) {
+                return false;
+            }
+            if (std::strcmp(argv[i], "--a") == 0 || std::strcmp(argv[i], "--b") == 0) {
+                const int engine = argv[i][2] == 'a' ? 0 : 1;
+                if (!parseEngine(value, options.engines[engine])) return false;
+                haveEngine[engine] = true;
+            } else if (std::strcmp(argv[i], "--games") == 0) {
+                options.games = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--concurrency") == 0) {
+                options.concurrency = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--size") == 0) {
+                options.boardSize = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--opening-plies") == 0) {
+                options.openingPlies = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--seed") == 0) {
+                options.seed = std::strtoull(value, nullptr, 10);
+            } else if (std::strcmp(argv[i], "--sprt") == 0) {
+                char comma = 0;
+                std::istringstream bounds(value);
+                if (!(bounds >> options.elo0 >> comma >> options.elo1) || comma != ',') return false;
+                options.sprt = true;
+            } else if (std::strcmp(argv[i], "--alpha") == 0) {
+                options.alpha = std::atof(value);
+            } else if (std::strcmp(argv[i], "--beta") == 0) {
+                options.beta = std::atof(value);
+            } else {
+                return false;
+            }
+            ++i;
+        }
+        return haveEngine[0] && haveEngine[1] && options.games >= 1 && options.concurrency >= 1 &&
+               options.openingPlies >= 1 && options.alpha > 0 && options.alpha < 1 &&
+               options.beta > 0 && options.beta < 1;
+    }
+
+    // Search statistics of one engine over a game
+    struct SideStats {
+        uint64_t moves = 0;
+        uint64_t searchedMoves = 0; // Moves not from the book, a forced win or a forced reply
+        uint64_t nodes = 0;
+        uint64_t depthSum = 0;
+        double milliseconds = 0;
+
+        SideStats& operator+=(const SideStats& other) {
+            moves += other.moves;
+            searchedMoves += other.searchedMoves;
+            nodes += other.nodes;
+            depthSum += other.depthSum;
+            milliseconds += other.milliseconds;
+            return *this;
+        }
+        [[nodiscard]] double nodesPerSecond() const { return milliseconds > 0 ? nodes * 1000.0 / milliseconds : 0; }
+        [[nodiscard]] double msPerMove() const { return moves ? milliseconds / moves : 0; }
+        [[nodiscard]] double averageDepth() const { return searchedMoves ? double(depthSum) / searchedMoves : 0; }
+    };
+
+    struct GameResult {
+        double scoreA = 0.5; // 1 win, 0.5 draw, 0 loss, for engine A
+        int plies = 0;
+        bool aIsBlack = true;
+        SideStats sides[2];
+    };
+
+    // Wins, draws and losses of engine A, with the Elo and SPRT arithmetic on them
+    struct Tally {
+        int wins = 0;
+        int draws = 0;
+        int losses = 0;
+
+        [[nodiscard]] int games() const { return wins + draws + losses; }
+        [[nodiscard]] double mean() const { return games() ? (wins + 0.5 * draws) / games() : 0.5; }
+        [[nodiscard]] double variance() const {
+            if (!games()) return 0;
+            const double m = mean();
+            return (wins * (1 - m) * (1 - m) + draws * (0.5 - m) * (0.5 - m) + losses * m * m) / games();
+        }
+
+        static double eloFromScore(const double score) { return -400 * std::log10(1 / score - 1); }
+        static double scoreFromElo(const double elo) { return 1 / (1 + std::pow(10, -elo / 400)); }
+
+        // Log-likelihood ratio of H1 (difference elo1) over H0 (elo0), normal approximation
+        [[nodiscard]] double logLikelihoodRatio(const double elo0, const double elo1) const {
+            const double var = variance();
+            if (var <= 0) return 0;
+            const double s0 = scoreFromElo(elo0);
+            const double s1 = scoreFromElo(elo1);
+            return games() * (s1 - s0) * (2 * mean() - s0 - s1) / (2 * var);
+        }
+    };
+
+    std::string formatElo(const double score) {
+        if (score <= 0 || score >= 1) return score <= 0 ? "-inf" : "+inf";
+        std::ostringstream text;
+        text << std::showpos << std::fixed << std::setprecision(1) << Tally::eloFromScore(score) + 0.0; // No "-0.0"
+        return text.str();
+    }
+
+    template <int Size>
+    void configure(BasicGomokuAI<Size>& engine, const EngineConfig& config) {
+        engine.setMaxDepth(config.depth);
+        engine.setTimeBudget(config.timeMs);
+        engine.setThreadCount(config.threads);
+        engine.setSearchMode(config.threads > 1 ? config.mode : SearchMode::Sequential);
+        engine.setTranspositionTableSize(config.tableSizeMB);
+        engine.setQuiescenceSearch(config.quiescence);
+        engine.setQuiescenceThrees(config.quiescenceThrees);
+        engine.setLateMoveReductions(config.lateMoveReductions);
+        engine.setNullMovePruning(config.nullMovePruning);
+        engine.setProofNumberSearch(config.proofNumberSearch);
+        engine.setVCFAtLeaves(config.vcfAtLeaves);
+        engine.setForcedWinPreCheck(config.forcedWinPreCheck);
+        engine.setEvaluationWeights(config.weights);
+    }
+
+    // Random moves near the stones already down, starting from the center. Stops short if a
+    // move would end the game.
+    template <int Size>
+    std::vector<BoardPosition> randomOpening(std::mt19937_64& rng, const int plies) {
+        BasicBoardManager<Size> board;
+        std::vector<BoardPosition> opening{{Size / 2, Size / 2}};
+        board.makeMove(opening.front());
+        while (static_cast<int>(opening.size()) < plies) {
+            const auto candidates = board.getCandidateMoves();
+            const BoardPosition move = *(candidates.begin() + rng() % candidates.size());
+            if (board.makeMove(move) != EMPTY) {
+                break;
+            }
+            opening.push_back(move);
+        }
+        return opening;
+    }
+
+    template <int Size>
+    GameResult playGame(const Options& options, const std::vector<BoardPosition>& opening, const bool aIsBlack) {
+        BasicBoardManager<Size> board;
+        for (const BoardPosition move : opening) {
+            board.makeMove(move);
+        }
+
+        // Index 0 is engine A
+        const char aColor = aIsBlack ? BLACK : WHITE;
+        const char bColor = aIsBlack ? WHITE : BLACK;
+        const char colors[2] = {aColor, bColor};
+        BasicGomokuAI<Size> engineA(colors[0]);
+        BasicGomokuAI<Size> engineB(colors[1]);
+        BasicGomokuAI<Size>* engines[2] = {&engineA, &engineB};
+        for (int side = 0; side < 2; ++side) {
+            configure(*engines[side], options.engines[side]);
+        }
+
+        GameResult result;
+        result.aIsBlack = aIsBlack;
+        char winner = EMPTY;
+        while (winner == EMPTY && !board.isBoardFull()) {
+            const int side = board.sideToMove() == colors[0] ? 0 : 1;
+            const auto start = std::chrono::steady_clock::now();
+            const BoardPosition move = engines[side]->getBestMove(board);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            SideStats& stats = result.sides[side];
+            ++stats.moves;
+            stats.nodes += engines[side]->lastSearchNodes();
+            // Only searches report a depth; averaging in the other moves would understate it
+            const int depth = engines[side]->lastSearchDepth();
+            stats.searchedMoves += depth > 0;
+            stats.depthSum += depth;
+            stats.milliseconds += std::chrono::duration<double, std::milli>(elapsed).count();
+
+            if (!board.isValidMove(move)) {
+                std::cerr << "Engine " << (side == 0 ? "A" : "B") << " played invalid move " << move
+                          << ", scoring the game as a loss" << std::endl;
+                winner = colors[1 - side];
+                break;
+            }
+            winner = board.makeMove(move);
+            ++result.plies;
+        }
+        result.scoreA = winner == colors[0] ? 1 : winner == EMPTY ? 0.5 : 0;
+        return result;
+    }
+
+    void printSideStats(const char* name, const SideStats& stats) {
+        std::cout << name << ": " << std::fixed << std::setprecision(0) << stats.nodesPerSecond() << " nodes/s, "
+                  << std::setprecision(1) << stats.msPerMove() << " ms/move, depth "
+                  << std::setprecision(2) << stats.averageDepth() << " over " << stats.searchedMoves << " searched of "
+                  << stats.moves << " moves" << std::endl;
+    }
+
+    template <int Size>
+    int runArena(const Options& options) {
+        // All openings up front, so results don't depend on the order games finish in
+        std::mt19937_64 rng(options.seed);
+        std::vector<std::vector<BoardPosition>> openings((options.games + 1) / 2);
+        for (auto& opening : openings) {
+            opening = randomOpening<Size>(rng, options.openingPlies);
+        }
+
+        const double lowerBound = std::log(options.beta / (1 - options.alpha));
+        const double upperBound = std::log((1 - options.beta) / options.alpha);
+
+        std::atomic<int> nextGame{0};
+        std::atomic<bool> decided{false};
+        std::mutex resultMutex;
+        Tally tally;
+        SideStats totals[2];
+
+        auto worker = [&] {
+            while (!decided.load(std::memory_order_relaxed)) {
+                const int game = nextGame.fetch_add(1, std::memory_order_relaxed);
+                if (game >= options.games) {
+                    return;
+                }
+                const GameResult result = playGame<Size>(options, openings[game / 2], game % 2 == 0);
+
+                const std::lock_guard lock(resultMutex);
+                if (result.scoreA == 1) ++tally.wins;
+                else if (result.scoreA == 0) ++tally.losses;
+                else ++tally.draws;
+                totals[0] += result.sides[0];
+                totals[1] += result.sides[1];
+
+                std::cout << "Game " << game + 1 << ": A (" << (result.aIsBlack ? "black" : "white") << ") "
+                          << (result.scoreA == 1 ? "1-0" : result.scoreA == 0 ? "0-1" : "1/2") << " B in "
+                          << result.plies << " plies | A " << std::fixed << std::setprecision(0)
+                          << result.sides[0].nodesPerSecond() << " n/s " << std::setprecision(1)
+                          << result.sides[0].msPerMove() << " ms/move | B " << std::setprecision(0)
+                          << result.sides[1].nodesPerSecond() << " n/s " << std::setprecision(1)
+                          << result.sides[1].msPerMove() << " ms/move | " << tally.wins << "-" << tally.losses
+                          << "-" << tally.draws << std::endl;
+
+                if (options.sprt) {
+                    const double llr = tally.logLikelihoodRatio(options.elo0, options.elo1);
+                    if (llr <= lowerBound || llr >= upperBound) {
+                        decided.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < std::min(options.concurrency, options.games); ++i) {
+            workers.emplace_back(worker);
+        }
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+
+        const double mean = tally.mean();
+        const double margin = 1.96 * std::sqrt(tally.variance() / std::max(1, tally.games()));
+        std::cout << "\nScore of A vs B: " << tally.wins << " - " << tally.losses << " - " << tally.draws
+                  << " [" << std::fixed << std::setprecision(3) << mean << "] " << tally.games() << " games\n"
+                  << "Elo difference: " << formatElo(mean) << " (95% " << formatElo(mean - margin) << " to "
+                  << formatElo(mean + margin) << ")" << std::endl;
+        if (options.sprt) {
+            const double llr = tally.logLikelihoodRatio(options.elo0, options.elo1);
+            std::cout << "SPRT elo0=" << std::setprecision(1) << options.elo0 << " elo1=" << options.elo1
+                      << ": LLR " << std::setprecision(2) << llr << " (" << lowerBound << ", " << upperBound << ") "
+                      << (llr >= upperBound ? "H1 accepted" : llr <= lowerBound ? "H0 accepted" : "inconclusive")
+                      << std::endl;
+        }
+        printSideStats("A", totals[0]);
+        printSideStats("B", totals[1]);
+        return 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int status = 1;
+    const bool supported = visitBoardSize(options.boardSize, [&](auto size) {
+        status = runArena<decltype(size)::value>(options);
+    });
+    if (!supported) {
+        std::cerr << "Unsupported board size " << options.boardSize << std::endl;
+        return 2;
+    }
+    return status;
+}
@@ -0,0 +1,147 @@
+//
+// Created by Samuel He on 2025/11/23.
+//
+
+#include "../Models/BoardManager.h"
+#include "../Models/BoardSize.h"
+#include "../Models/OpeningBook.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Builds an opening book from game records.
+//
+// Records are plain text, one game per line: moves as "row,col" separated by spaces, black
+// first. Blank lines and lines starting with '#' are skipped. For every position in the first
+// --plies moves the book keeps the most played reply, if it was played at least --min-count
+// times; positions that are rotations or mirrors of each other are counted together.
+
+namespace {
+    struct Options {
+        std::string recordsPath;
+        std::string bookPath;
+        int boardSize = BOARD_SIZE;
+        int plies = BOOK_MAX_PLY;
+        int minCount = 2;
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <records.txt> <book.bin>"
+                  << " [--size N] [--plies N] [--min-count N]\n";
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        std::vector<std::string> positional;
+        for (int i = 1; i < argc; ++i) {
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (std::strcmp(argv[i], "--size") == 0 && value) {
+                options.boardSize = std::atoi(value);
+                ++i;
+            } else if (std::strcmp(argv[i], "--plies") == 0 && value) {
+                options.plies = std::atoi(value);
+                ++i;
+            } else if (std::strcmp(argv[i], "--min-count") == 0 && value) {
+                options.minCount = std::atoi(value);
+                ++i;
+            } else {
+                positional.emplace_back(argv[i]);
+            }
+        }
+        if (positional.size() != 2 || options.plies < 1 || options.minCount < 1) {
+            return false;
+        }
+        options.recordsPath = positional[0];
+        options.bookPath = positional[1];
+        return true;
+    }
+
+    template <int Size>
+    int buildBook(const Options& options) {
+        using Book = BasicOpeningBook<Size>;
+        using Board = BasicBoardManager<Size>;
+
+        std::ifstream records(options.recordsPath);
+        if (!records) {
+            std::cerr << "Cannot read " << options.recordsPath << std::endl;
+            return 1;
+        }
+
+        // Canonical key -> (canonical cell index -> games it was played in)
+        std::unordered_map<uint64_t, std::map<int, uint32_t>> replies;
+        int games = 0;
+        std::string line;
+        for (int lineNumber = 1; std::getline(records, line); ++lineNumber) {
+            if (line.empty() || line[0] == '#') continue;
+
+            Board board;
+            std::istringstream moves(line);
+            std::string token;
+            for (int ply = 0; ply < options.plies && moves >> token; ++ply) {
+                BoardPosition move{-1, -1};
+                char comma = 0;
+                std::istringstream cell(token);
+                if (!(cell >> move.row >> comma >> move.col) || comma != ',' || !board.isValidMove(move)) {
+                    std::cerr << options.recordsPath << ":" << lineNumber
+                              << ": bad move \"" << token << "\", skipping the rest of the game" << std::endl;
+                    break;
+                }
+
+                const auto [key, symmetry] = board.canonicalHash();
+                // The empty board is answered without the book
+                if (key != 0) {
+                    const BoardPosition canonical = Board::transform(move, symmetry);
+                    ++replies[key][canonical.row * Size + canonical.col];
+                }
+                if (board.makeMove(move) != EMPTY) break;
+            }
+            ++games;
+        }
+
+        std::vector<typename Book::Entry> entries;
+        for (const auto& [key, counts] : replies) {
+            int bestCell = -1;
+            uint32_t bestCount = 0;
+            for (const auto& [cell, count] : counts) {
+                if (count > bestCount) {
+                    bestCell = cell;
+                    bestCount = count;
+                }
+            }
+            if (bestCount >= uint32_t(options.minCount)) {
+                entries.push_back({key, uint8_t(bestCell / Size), uint8_t(bestCell % Size), 0, bestCount});
+            }
+        }
+
+        if (!Book::write(QString::fromStdString(options.bookPath), entries)) {
+            return 1;
+        }
+        std::cout << "Read " << games << " games, " << replies.size() << " positions; wrote "
+                  << entries.size() << " book entries to " << options.bookPath << std::endl;
+        return 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int status = 1;
+    const bool supported = visitBoardSize(options.boardSize, [&](auto size) {
+        status = buildBook<decltype(size)::value>(options);
+    });
+    if (!supported) {
+        std::cerr << "Unsupported board size " << options.boardSize << std::endl;
+        return 2;
+    }
+    return status;
+}
@@ -0,0 +1,204 @@
+//
+// Created by Samuel He on 2025/11/24.
+//
+
+#include "../Models/BoardManager.h"
+#include "../Models/BoardSize.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Enumerates the whole candidate-move tree of a position to a fixed depth through makeMove(),
+// undoMove() and getCandidateMoves(), the way chess engines check their move generators.
+//
+// A move that wins or fills the board ends its line and counts as a leaf wherever it occurs.
+// Besides the leaf count the tool prints the sum of the leaves' Zobrist keys: two board or
+// candidate-cache implementations that agree on both generate the same trees. Positions are
+// moves as "row,col" separated by spaces, black first, as in the opening book records; with
+// none, the tree starts after a stone in the center.
+
+namespace {
+    struct Options {
+        std::string moves;
+        int boardSize = BOARD_SIZE;
+        int depth = 3;
+        int threads = 1;
+        bool divide = false;
+    };
+
+    struct Count {
+        uint64_t leaves = 0;
+        uint64_t nodes = 0;    // Moves made, i.e. every node below the root
+        uint64_t leafHash = 0; // Sum of the leaves' keys
+
+        Count& operator+=(const Count& other) {
+            leaves += other.leaves;
+            nodes += other.nodes;
+            leafHash += other.leafHash;
+            return *this;
+        }
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--moves \"r,c r,c ...\"] [--depth N] [--size N] [--threads N]"
+                  << " [--divide]\n";
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--divide") == 0) {
+                options.divide = true;
+                continue;
+            }
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (!value) {
+                return false;
+            }
+            if (std::strcmp(argv[i], "--moves") == 0) {
+                options.moves = value;
+            } else if (std::strcmp(argv[i], "--depth") == 0) {
+                options.depth = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--size") == 0) {
+                options.boardSize = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--threads") == 0) {
+                options.threads = std::atoi(value);
+            } else {
+                return false;
+            }
+            ++i;
+        }
+        return options.depth >= 1 && options.threads >= 1;
+    }
+
+    template <int Size>
+    bool setUpPosition(const std::string& moves, BasicBoardManager<Size>& board) {
+        std::istringstream tokens(moves);
+        std::string token;
+        while (tokens >> token) {
+            BoardPosition move{-1, -1};
+            char comma = 0;
+            std::istringstream cell(token);
+            if (!(cell >> move.row >> comma >> move.col) || comma != ',' || !board.isValidMove(move)) {
+                std::cerr << "Bad move \"" << token << "\"" << std::endl;
+                return false;
+            }
+            if (board.makeMove(move) != EMPTY || board.isBoardFull()) {
+                std::cerr << "The game is already over after " << token << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <int Size>
+    void perft(BasicBoardManager<Size>& board, const int depth, Count& count) {
+        if (depth == 0) {
+            ++count.leaves;
+            count.leafHash += board.hash();
+            return;
+        }
+
+        // The view is invalidated by the next make/undo, so copy it
+        BoardPosition moves[BasicBoardManager<Size>::CELL_COUNT];
+        const auto candidates = board.getCandidateMoves();
+        const int moveCount = static_cast<int>(std::copy(candidates.begin(), candidates.end(), moves) - moves);
+
+        for (int i = 0; i < moveCount; ++i) {
+            ++count.nodes;
+            if (board.makeMove(moves[i]) != EMPTY || board.isBoardFull()) {
+                ++count.leaves;
+                count.leafHash += board.hash();
+            } else {
+                perft(board, depth - 1, count);
+            }
+            board.undoMove();
+        }
+    }
+
+    template <int Size>
+    int runPerft(const Options& options) {
+        using Board = BasicBoardManager<Size>;
+
+        Board root;
+        if (!setUpPosition(options.moves, root)) {
+            return 1;
+        }
+        if (root.isBoardEmpty()) {
+            // getCandidateMoves() is empty until the first stone, so start from the opening move
+            root.makeMove({Size / 2, Size / 2});
+        }
+
+        const auto view = root.getCandidateMoves();
+        const std::vector<BoardPosition> rootMoves(view.begin(), view.end());
+        std::vector<Count> counts(rootMoves.size());
+
+        // Root moves are handed out one at a time, each thread searching its own board copy
+        const auto start = std::chrono::steady_clock::now();
+        std::atomic<size_t> nextMove{0};
+        auto worker = [&] {
+            Board board = root;
+            for (size_t i = nextMove.fetch_add(1); i < rootMoves.size(); i = nextMove.fetch_add(1)) {
+                Count& count = counts[i];
+                ++count.nodes;
+                if (board.makeMove(rootMoves[i]) != EMPTY || board.isBoardFull()) {
+                    ++count.leaves;
+                    count.leafHash += board.hash();
+                } else {
+                    perft(board, options.depth - 1, count);
+                }
+                board.undoMove();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int i = 1; i < options.threads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Count total;
+        for (size_t i = 0; i < rootMoves.size(); ++i) {
+            if (options.divide) {
+                std::cout << rootMoves[i].row << "," << rootMoves[i].col << ": " << counts[i].leaves << std::endl;
+            }
+            total += counts[i];
+        }
+        std::cout << "Depth " << options.depth << ": " << total.leaves << " leaves, " << total.nodes << " nodes, leaf hash "
+                  << std::hex << std::setw(16) << std::setfill('0') << total.leafHash << std::dec << std::setfill(' ')
+                  << "\n" << std::fixed << std::setprecision(3) << seconds << " s, " << std::setprecision(0)
+                  << (seconds > 0 ? total.nodes / seconds : 0) << " nodes/s on " << options.threads << " thread(s)"
+                  << std::endl;
+        return 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int status = 1;
+    const bool supported = visitBoardSize(options.boardSize, [&](auto size) {
+        status = runPerft<decltype(size)::value>(options);
+    });
+    if (!supported) {
+        std::cerr << "Unsupported board size " << options.boardSize << std::endl;
+        return 2;
+    }
+    return status;
+}
@@ -0,0 +1,187 @@
+//
+// Created by Samuel He on 2025/11/25.
+//
+
+#include "../Models/BoardManager.h"
+#include "../Models/BoardSize.h"
+#include "../Models/ProofNumberSolver.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Labels recorded positions with the df-pn solver: whether the side to move has a forced win
+// through the threat space, and the winning move if so.
+//
+// Positions are plain text, one per line: moves as "row,col" separated by spaces, black first,
+// as in the opening book records. Blank lines and lines starting with '#' are skipped. Each
+// position is printed back followed by its label, "win r,c", "no-win" or "unknown" when the
+// budget ran out. With --every-ply each prefix of a record is labelled too, which shows where
+// a game record let a won position go.
+
+namespace {
+    struct Options {
+        std::string positionsPath;
+        int boardSize = BOARD_SIZE;
+        uint64_t maxNodes = PN_MAX_NODES;
+        int timeLimitMs = 0;
+        int maxPly = PN_MAX_PLY;
+        bool everyPly = false;
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <positions.txt> [--size N] [--nodes N] [--time MS] [--ply N]"
+                  << " [--every-ply]\n";
+    }
+
+    bool parseOptions(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--every-ply") == 0) {
+                options.everyPly = true;
+                continue;
+            }
+            if (argv[i][0] != '-' && options.positionsPath.empty()) {
+                options.positionsPath = argv[i];
+                continue;
+            }
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (!value) {
+                return false;
+            }
+            if (std::strcmp(argv[i], "--size") == 0) {
+                options.boardSize = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--nodes") == 0) {
+                options.maxNodes = std::strtoull(value, nullptr, 10);
+            } else if (std::strcmp(argv[i], "--time") == 0) {
+                options.timeLimitMs = std::atoi(value);
+            } else if (std::strcmp(argv[i], "--ply") == 0) {
+                options.maxPly = std::atoi(value);
+            } else {
+                return false;
+            }
+            ++i;
+        }
+        return !options.positionsPath.empty() && options.maxNodes > 0 && options.maxPly > 0;
+    }
+
+    bool parseMoves(const std::string& line, std::vector<BoardPosition>& moves) {
+        std::istringstream tokens(line);
+        std::string token;
+        while (tokens >> token) {
+            BoardPosition move{-1, -1};
+            char comma = 0;
+            std::istringstream cell(token);
+            if (!(cell >> move.row >> comma >> move.col) || comma != ',') {
+                std::cerr << "Bad move \"" << token << "\"" << std::endl;
+                return false;
+            }
+            moves.push_back(move);
+        }
+        return true;
+    }
+
+    template <int Size>
+    void label(BasicProofNumberSolver<Size>& solver, BasicBoardManager<Size>& board, const std::string& position) {
+        using Result = typename BasicProofNumberSolver<Size>::Result;
+
+        BoardPosition winningMove{-1, -1};
+        const auto start = std::chrono::steady_clock::now();
+        const Result result = solver.prove(board, board.sideToMove(), &winningMove);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << position << "\t";
+        switch (result) {
+            case Result::Proven:
+                std::cout << "win " << winningMove.row << "," << winningMove.col;
+                break;
+            case Result::Disproven:
+                std::cout << "no-win";
+                break;
+            default:
+                std::cout << "unknown";
+                break;
+        }
+        std::cout << "\t" << solver.lastNodes() << " nodes, " << std::fixed << std::setprecision(1) << ms << " ms"
+                  << std::endl;
+    }
+
+    template <int Size>
+    int runLabeler(const Options& options) {
+        std::ifstream input(options.positionsPath);
+        if (!input) {
+            std::cerr << "Cannot open " << options.positionsPath << std::endl;
+            return 1;
+        }
+
+        BasicProofNumberSolver<Size> solver;
+        solver.setMaxNodes(options.maxNodes);
+        solver.setTimeLimit(options.timeLimitMs);
+        solver.setMaxPly(options.maxPly);
+
+        std::string line;
+        int lineNumber = 0;
+        int labelled = 0;
+        while (std::getline(input, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::vector<BoardPosition> moves;
+            if (!parseMoves(line, moves)) {
+                std::cerr << "Skipping line " << lineNumber << std::endl;
+                continue;
+            }
+
+            BasicBoardManager<Size> board;
+            std::string played;
+            bool over = false;
+            for (size_t i = 0; i < moves.size() && !over; ++i) {
+                if (!board.isValidMove(moves[i])) {
+                    std::cerr << "Illegal move on line " << lineNumber << std::endl;
+                    over = true;
+                    break;
+                }
+                over = board.makeMove(moves[i]) != EMPTY || board.isBoardFull();
+                played += (played.empty() ? "" : " ") + std::to_string(moves[i].row) + "," +
+                          std::to_string(moves[i].col);
+                if (options.everyPly && !over && i + 1 < moves.size()) {
+                    label(solver, board, played);
+                    ++labelled;
+                }
+            }
+            if (over) {
+                continue; // Nothing left to prove
+            }
+            label(solver, board, played);
+            ++labelled;
+        }
+
+        std::cerr << "Labelled " << labelled << " positions" << std::endl;
+        return 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int status = 1;
+    const bool supported = visitBoardSize(options.boardSize, [&](auto size) {
+        status = runLabeler<decltype(size)::value>(options);
+    });
+    if (!supported) {
+        std::cerr << "Unsupported board size " << options.boardSize << std::endl;
+        return 2;
+    }
+    return status;
+}
@@ -16,6 +16,7 @@ GameWidget::GameWidget(QWidget *parent) : QWidget(parent) {
 GameWidget::~GameWidget() {
     // Clean up the game thread
     if (gameThread) {
+        gameManager->cancelSearch();
         gameThread->quit();
         gameThread->wait();
     }
@@ -127,6 +128,9 @@ void GameWidget::connectResetButton() {
     connect(resetButton, &QPushButton::clicked, this, [this]() {
         // Interrupt any ongoing AI work, stop old thread and manager
         if (gameThread) {
+            // The search polls a stop token, not the thread's interruption flag, so cancel it
+            // directly; otherwise wait() below lasts until the AI's move is done
+            gameManager->cancelSearch();
             gameThread->requestInterruption();
             disconnect(gameManager, nullptr, this, nullptr);
             disconnect(gameManager, nullptr, board, nullptr);